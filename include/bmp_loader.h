@@ -5,6 +5,8 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include "fbtft_scaler.h"
+#include "fbtft_alpha.h"
 
 // BMP文件头结构
 #pragma pack(push, 1)
@@ -32,21 +34,61 @@ typedef struct {
 #pragma pack(pop)
 
 // BMP图像数据结构
+// bmp_load 分配的 data 来自缓冲区池 (fbtft_pool)，前面带有池的块头：
+// 只能用 bmp_free 释放，不能直接 free(image.data)。
+// 调用者自己填充 data 时 owns_data 必须为0，由调用者自行释放。
 typedef struct {
     int width;
     int height;
     int bpp;                // 每像素位数
     uint16_t *data;         // RGB565格式的像素数据
+    int owns_data;          // data是否由bmp_free释放 (只由加载函数置1，bmp_load_into时为0)
 } BMPImage;
 
+// 文件头中的图像信息
+typedef struct {
+    int width;
+    int height;
+    int bpp;                // 每像素位数
+} BMPInfo;
+
+// 图像适配模式
+typedef enum {
+    FIT_SCALE = 0,      // 保持宽高比缩放（默认）
+    FIT_STRETCH = 1,    // 拉伸填充屏幕
+    FIT_AUTO = 2        // 自动旋转以最佳适配
+} fit_mode_t;
+
 // 函数声明
+// 加载成功后 image 只能用 bmp_free 释放 (见 BMPImage 的说明)
 int bmp_load(const char *filename, BMPImage *image);
 void bmp_free(BMPImage *image);
 int bmp_convert_to_rgb565(BMPImage *image, uint16_t *buffer, int buf_width, int buf_height);
 int bmp_convert_to_rgb565_smart_fit(BMPImage *image, uint16_t *buffer, int buf_width, int buf_height, int auto_rotate);
+int bmp_convert_fit(BMPImage *image, uint16_t *buffer, int buf_width, int buf_height, fit_mode_t fit);
+
+// 使用调用者提供的内存，不分配堆内存
+int bmp_get_info(const char *filename, int *width, int *height, int *bpp);
+int bmp_load_into(const char *filename, BMPImage *image, uint16_t *buffer, size_t buffer_pixels);
+
+// 边解码边缩放，不分配完整的源图像 (适合远大于屏幕的图片)
+int bmp_load_scaled(const char *filename, uint16_t *buffer, int buf_width, int buf_height, int buf_stride, 
+                    scale_filter_t filter, scale_policy_t policy, uint16_t bg_color);
+int bmp_load_fit(const char *filename, uint16_t *buffer, int buf_width, int buf_height, fit_mode_t fit);
+// 适配后再旋转，buf_width/buf_height 为旋转后的尺寸；info 可为NULL
+int bmp_load_fit_rotated(const char *filename, uint16_t *buffer, int buf_width, int buf_height, 
+                         fit_mode_t fit, rotation_t rotation, BMPInfo *info);
 int bmp_draw_to_buffer(const char *filename, uint16_t *buffer, int buf_width, int buf_height, 
                       int dst_x, int dst_y);
 
+// 只解码图像中 (x, y) 开始的 w x h 区域，buf_stride 为0时等于 w
+int bmp_load_region(const char *filename, int x, int y, int w, int h, uint16_t *buffer, int buf_stride);
+
+// 按32位BMP的alpha通道加载为预乘alpha图像，或直接叠加到缓冲区
+int bmp_load_alpha(const char *filename, fbtft_alpha_image_t *image);
+int bmp_blend_to_buffer(const char *filename, uint16_t *buffer, int buf_width, int buf_height, 
+                        int dst_x, int dst_y);
+
 // 颜色转换工具
 uint16_t bgr_to_rgb565(uint8_t b, uint8_t g, uint8_t r);
 void rgb565_to_bgr(uint16_t color, uint8_t *b, uint8_t *g, uint8_t *r);
@@ -0,0 +1,33 @@
+#ifndef _COLOR_CONVERT_H_
+#define _COLOR_CONVERT_H_
+
+#include <stdint.h>
+
+// 行级像素格式转换 (NEON / SSSE3 / SSE2 / 标量，首次调用时按CPU特性选择实现)
+// src 为按字节排列的像素，dst 为RGB565，count 为像素数；src 与 dst 不能重叠
+
+// 24位 BGR (BMP的字节顺序) -> RGB565
+void convert_row_bgr888_to_rgb565(uint16_t *dst, const uint8_t *src, int count);
+
+// 32位 BGRA (忽略alpha) -> RGB565
+void convert_row_bgra8888_to_rgb565(uint16_t *dst, const uint8_t *src, int count);
+
+// 32位 BGRA -> 预乘alpha的RGB565，alpha 单独输出到每像素一个字节
+void convert_row_bgra8888_to_rgb565_premul(uint16_t *dst, uint8_t *alpha, const uint8_t *src, int count);
+
+// 16位 X1R5G5B5 (小端) -> RGB565，绿色最低位用最高位补齐
+void convert_row_rgb555_to_rgb565(uint16_t *dst, const uint8_t *src, int count);
+
+// 调色板索引 -> RGB565，lut 为预先转换好的256项RGB565调色板
+// 4位和1位索引按高位在前的顺序排列，与BMP相同
+void convert_row_index8_to_rgb565(uint16_t *dst, const uint8_t *src, int count, const uint16_t *lut);
+void convert_row_index4_to_rgb565(uint16_t *dst, const uint8_t *src, int count, const uint16_t *lut);
+void convert_row_index1_to_rgb565(uint16_t *dst, const uint8_t *src, int count, const uint16_t *lut);
+
+// RGB565 -> 24位 BGR，各通道按高位复制扩展到8位
+void convert_row_rgb565_to_bgr888(uint8_t *dst, const uint16_t *src, int count);
+
+// 当前使用的实现名称 ("neon", "ssse3", "sse2", "scalar")
+const char *convert_row_backend(void);
+
+#endif /* _COLOR_CONVERT_H_ */
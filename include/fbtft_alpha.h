@@ -0,0 +1,47 @@
+#ifndef _FBTFT_ALPHA_H_
+#define _FBTFT_ALPHA_H_
+
+#include "fbtft_surface.h"
+
+// 预乘alpha的RGB565 + A8图像 (图标、电量和信号指示器等叠加层)
+// 颜色已乘以alpha，叠加时 d = s + d * (255 - a) / 255；
+// 每行按alpha划分为不透明和半透明两种游程，完全透明的像素不记录：
+// 叠加时透明部分直接跳过，不透明部分直接复制，只有半透明部分逐像素混合
+
+// 游程坐标为16位，图像宽度不能超过该值
+#define FBTFT_ALPHA_MAX_WIDTH       65535
+
+// 短于该长度的透明/不透明段与相邻的半透明段合并，避免游程过碎
+#define FBTFT_ALPHA_MIN_RUN         8
+
+// alpha游程
+typedef struct {
+    uint16_t x;                         // 起始列
+    uint16_t length;                    // 像素数
+    uint8_t opaque;                     // 1: alpha全为255，直接复制；0: 需要混合
+} fbtft_alpha_run_t;
+
+// 预乘alpha图像
+typedef struct {
+    uint16_t *color;                    // 预乘后的RGB565 (行距等于宽度)
+    uint8_t *alpha;                     // 每像素alpha (0透明 ~ 255不透明)
+    int width;                          // 宽度
+    int height;                         // 高度
+    fbtft_alpha_run_t *runs;            // 所有行的游程
+    int *row_runs;                      // 每行第一个游程的序号 (height + 1 项)
+    int run_count;                      // 游程总数
+} fbtft_alpha_image_t;
+
+// 创建全透明的图像和释放
+int fbtft_alpha_create(fbtft_alpha_image_t *image, int width, int height);
+void fbtft_alpha_destroy(fbtft_alpha_image_t *image);
+
+// 直接修改 color/alpha 之后重新计算游程
+int fbtft_alpha_update_runs(fbtft_alpha_image_t *image);
+
+// 把图像叠加到不透明的表面上 (只写入裁剪矩形以内的像素)
+void fbtft_alpha_blend(fbtft_surface_t *dst, int x, int y, const fbtft_alpha_image_t *src);
+// 把图像叠加到另一幅预乘alpha图像上 (用于组合叠加层)，完成后目标的游程自动更新
+int fbtft_alpha_blend_over(fbtft_alpha_image_t *dst, int x, int y, const fbtft_alpha_image_t *src);
+
+#endif /* _FBTFT_ALPHA_H_ */
@@ -0,0 +1,65 @@
+#ifndef _FBTFT_ASSET_H_
+#define _FBTFT_ASSET_H_
+
+#include "fbtft_lcd.h"
+#include "bmp_loader.h"
+
+// 预先适配好的RGB565资源文件
+// 离线按屏幕尺寸、适配模式和旋转方向转换完成，像素已经是framebuffer的方向，
+// 运行时mmap后直接复制到framebuffer，不需要解码和格式转换
+//
+// 文件布局 (小端)：32字节文件头，之后是16字节对齐的像素数据，每行按stride字节对齐
+
+#define FBTFT_ASSET_MAGIC       "F565"
+#define FBTFT_ASSET_VERSION     1
+#define FBTFT_ASSET_ALIGN       16      // 像素数据起始位置和每行字节数的对齐
+
+// 像素格式
+typedef enum {
+    FBTFT_ASSET_RGB565 = 0              // 16位 RGB565
+} fbtft_asset_format_t;
+
+// 文件头
+#pragma pack(push, 1)
+typedef struct {
+    char magic[4];                      // "F565"
+    uint16_t version;                   // 格式版本
+    uint16_t format;                    // 像素格式 (fbtft_asset_format_t)
+    uint32_t width;                     // 宽度
+    uint32_t height;                    // 高度
+    uint32_t stride;                    // 每行字节数 (FBTFT_ASSET_ALIGN的倍数)
+    uint32_t data_offset;               // 像素数据偏移 (FBTFT_ASSET_ALIGN的倍数)
+    uint32_t data_size;                 // 像素数据字节数
+    uint32_t reserved;                  // 保留，写0
+} fbtft_asset_header_t;
+#pragma pack(pop)
+
+// 已映射的资源
+typedef struct {
+    void *map;                          // 整个文件的映射
+    size_t map_size;                    // 映射大小
+    const uint16_t *pixels;             // 像素数据 (指向映射内部)
+    int width;                          // 宽度
+    int height;                         // 高度
+    int stride;                         // 每行像素数
+    fbtft_asset_format_t format;        // 像素格式
+} fbtft_asset_t;
+
+// 映射和释放
+int fbtft_asset_open(fbtft_asset_t *asset, const char *path);
+void fbtft_asset_close(fbtft_asset_t *asset);
+
+// 显示到LCD (资源尺寸必须与屏幕相同)
+int fbtft_asset_present(fbtft_lcd_t *lcd, const fbtft_asset_t *asset);
+int fbtft_asset_show(fbtft_lcd_t *lcd, const char *path);
+
+// 写入资源文件，stride 为源缓冲区每行像素数
+int fbtft_asset_write(const char *path, const uint16_t *pixels, int width, int height, int stride);
+
+// 把BMP按适配模式和旋转/镜像转换为 panel_width x panel_height 的资源文件
+// info 不为NULL时返回源图像信息
+int fbtft_asset_convert_bmp(const char *bmp_path, const char *asset_path,
+                            int panel_width, int panel_height, fit_mode_t fit,
+                            rotation_t rotation, mirror_t mirror, BMPInfo *info);
+
+#endif /* _FBTFT_ASSET_H_ */
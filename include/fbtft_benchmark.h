@@ -3,6 +3,14 @@
 
 #include "fbtft_lcd.h"
 #include "bmp_loader.h"
+#include "fbtft_pacer.h"
+#include "fbtft_surface.h"
+#include "fbtft_scaler.h"
+#include "fbtft_threadpool.h"
+#include "fbtft_image_cache.h"
+#include "fbtft_playlist.h"
+#include "fbtft_pool.h"
+#include "fbtft_ingest.h"
 #include <time.h>
 #include <sys/time.h>
 #include <signal.h>
@@ -13,19 +21,16 @@
 #define MAX_PATH_LEN            256
 #define BENCHMARK_DURATION_SEC  30
 #define FPS_UPDATE_INTERVAL     100  // 每100帧更新一次FPS显示
-
-// 图像适配模式
-typedef enum {
-    FIT_SCALE = 0,      // 保持宽高比缩放（默认）
-    FIT_STRETCH = 1,    // 拉伸填充屏幕
-    FIT_AUTO = 2        // 自动旋转以最佳适配
-} fit_mode_t;
+#define IMAGE_CACHE_BYTES       (4 * 1024 * 1024)  // 已适配帧缓存的内存预算
 
 // 全局显示配置
 typedef struct {
     rotation_t rotation;        // 旋转角度
     mirror_t mirror;           // 镜像方式
     fit_mode_t fit_mode;       // 图像适配模式
+    int target_fps;            // 目标帧率 (0 = 不限制，全速运行)
+    int threads;               // 像素处理线程数 (0 = 单线程，-1 = 按CPU核数自动选择)
+    int prefetch_depth;        // 后台预取解码的图片数 (0 = FBTFT_PLAYLIST_DEFAULT_DEPTH)
 } display_config_t;
 
 // 图像信息结构
@@ -47,6 +52,7 @@ typedef struct {
 
 // 函数声明
 void fbtft_benchmark_run(const display_config_t *config);
+void fbtft_benchmark_rotation(void);
 void benchmark_signal_handler(int sig);
 unsigned long long get_current_time_ms(void);
 int scan_bmp_files(ImageInfo images[], int max_images);
@@ -55,5 +61,7 @@ void display_final_results(fbtft_lcd_t *lcd, uint16_t *buffer, BenchmarkStats *s
 void print_progress(BenchmarkStats *stats);
 void draw_text_simple(uint16_t *buffer, int width, int height, int x, int y, 
                      const char *text, uint16_t color, uint16_t bg_color);
+void draw_text_landscape(uint16_t *buffer, int width, int height, int x, int y, 
+                        const char *text, uint16_t color, uint16_t bg_color);
 
 #endif /* _FBTFT_BENCHMARK_H_ */
@@ -0,0 +1,70 @@
+#ifndef _FBTFT_IMAGE_CACHE_H_
+#define _FBTFT_IMAGE_CACHE_H_
+
+#include "fbtft_lcd.h"
+#include "fbtft_surface.h"
+#include "bmp_loader.h"
+#include <pthread.h>
+#include <time.h>
+#include <sys/types.h>
+
+// 已解码并适配到目标尺寸的RGB565帧缓存
+// 以 路径/修改时间/文件大小/目标尺寸/适配模式/旋转 为键，按内存预算做LRU淘汰；
+// 帧在放入缓存前已经旋转到屏幕方向，命中时只需一次复制，文件被修改后旧的帧自动失效
+
+// 缓存的一帧
+typedef struct fbtft_image_entry {
+    char *path;                         // 文件路径 (存放在表项之后)
+    struct timespec mtime;              // 文件修改时间
+    off_t file_size;                    // 文件大小
+    int width;                          // 帧宽度 (旋转后)
+    int height;                         // 帧高度 (旋转后)
+    fit_mode_t fit;                     // 适配模式
+    rotation_t rotation;                // 帧已经旋转的方向
+    uint16_t *pixels;                   // 帧数据 (行距等于宽度)
+    size_t bytes;                       // 帧数据占用的内存
+    struct fbtft_image_entry *prev;     // 更近使用的一项
+    struct fbtft_image_entry *next;     // 更久未使用的一项
+} fbtft_image_entry_t;
+
+// 缓存统计
+typedef struct {
+    unsigned long long hits;            // 命中次数
+    unsigned long long misses;          // 未命中次数 (需要完整解码)
+    unsigned long long evictions;       // 被淘汰或失效的帧数量
+    int entries;                        // 当前缓存的帧数量
+    size_t bytes;                       // 当前缓存占用的内存
+    size_t budget;                      // 内存预算
+} fbtft_image_cache_stats_t;
+
+// 帧缓存
+typedef struct {
+    pthread_mutex_t lock;               // 保护链表和统计
+    fbtft_image_entry_t *head;          // 最近使用的一项
+    fbtft_image_entry_t *tail;          // 最久未使用的一项
+    size_t budget;                      // 内存预算 (字节)
+    size_t bytes;                       // 已使用的内存
+    int entries;                        // 帧数量
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long evictions;
+} fbtft_image_cache_t;
+
+// 初始化和释放
+int fbtft_image_cache_init(fbtft_image_cache_t *cache, size_t budget_bytes);
+void fbtft_image_cache_deinit(fbtft_image_cache_t *cache);
+
+// 把图像按适配模式、旋转后写满 dst 表面 (目标尺寸取自表面)，未命中时解码并缓存
+int fbtft_image_cache_load(fbtft_image_cache_t *cache, const char *path, fbtft_surface_t *dst,
+                           fit_mode_t fit, rotation_t rotation);
+
+// 只解码并放入缓存，不输出像素；info 不为NULL时返回源图像信息
+int fbtft_image_cache_preload(fbtft_image_cache_t *cache, const char *path, int width, int height,
+                              fit_mode_t fit, rotation_t rotation, BMPInfo *info);
+
+// 清空缓存和统计
+void fbtft_image_cache_clear(fbtft_image_cache_t *cache);
+void fbtft_image_cache_get_stats(fbtft_image_cache_t *cache, fbtft_image_cache_stats_t *stats);
+void fbtft_image_cache_reset_stats(fbtft_image_cache_t *cache);
+
+#endif /* _FBTFT_IMAGE_CACHE_H_ */
@@ -0,0 +1,68 @@
+#ifndef _FBTFT_INGEST_H_
+#define _FBTFT_INGEST_H_
+
+#include "fbtft_lcd.h"
+#include "bmp_loader.h"
+#include "fbtft_image_cache.h"
+
+// 批量导入图片
+// 由共享线程池并行校验、解码、转换和适配每张图片 (每个文件只映射一次，只校验时不读取像素数据)，
+// 结果放入已适配帧缓存或写成资源文件；
+// 结果按路径排序，与线程调度和目录顺序无关
+
+// 导入时每个文件的处理方式
+typedef enum {
+    FBTFT_INGEST_VALIDATE = 0,          // 只校验文件头
+    FBTFT_INGEST_CACHE,                 // 解码并适配后放入帧缓存
+    FBTFT_INGEST_ASSET                  // 转换为资源文件 (asset_dir/<文件名>.f565)
+} fbtft_ingest_target_t;
+
+// 导入配置
+typedef struct {
+    fbtft_ingest_target_t target;       // 处理方式
+    int width;                          // 帧宽度 (旋转后，即屏幕宽度)
+    int height;                         // 帧高度
+    fit_mode_t fit;                     // 适配模式
+    rotation_t rotation;                // 旋转方向 (写入缓存的帧或资源文件的像素)
+    mirror_t mirror;                    // 镜像方式 (仅ASSET)
+    fbtft_image_cache_t *cache;         // CACHE：目标缓存
+    const char *asset_dir;              // ASSET：资源文件输出目录
+    int workers;                        // 线程数 (0 = 沿用共享线程池的设置，>0 时调整共享线程池)
+} fbtft_ingest_config_t;
+
+// 单个文件的结果
+typedef struct {
+    char *path;                         // 图片路径
+    char *asset_path;                   // ASSET：生成的资源文件路径，否则为NULL
+    int status;                         // 0: 成功；-1: 文件头无效或处理失败
+    int width;                          // 图像宽度
+    int height;                         // 图像高度
+    int bpp;                            // 位深
+    long long file_bytes;               // 文件大小
+    long long decode_ns;                // 校验和处理的总耗时
+} fbtft_ingest_item_t;
+
+// 导入结果
+typedef struct {
+    fbtft_ingest_item_t *items;         // 按路径排序的结果
+    int count;                          // 文件数量
+    int succeeded;                      // 成功的文件数
+    int failed;                         // 失败的文件数
+    int workers;                        // 实际使用的工作线程数
+    long long wall_ns;                  // 整个导入的耗时
+    long long busy_ns;                  // 所有文件耗时之和
+    long long total_bytes;              // 成功的文件大小之和
+    long long total_pixels;             // 成功的图像像素数之和
+} fbtft_ingest_result_t;
+
+// 导入目录中所有 .bmp 文件 (不区分大小写，不递归)
+int fbtft_ingest_dir(const char *dir, const fbtft_ingest_config_t *config, fbtft_ingest_result_t *result);
+// 导入给定的文件列表
+int fbtft_ingest_list(const char *const *paths, int count, const fbtft_ingest_config_t *config,
+                      fbtft_ingest_result_t *result);
+void fbtft_ingest_free(fbtft_ingest_result_t *result);
+
+// 打印吞吐量，per_file 非0时同时打印每个文件的结果
+void fbtft_ingest_print_report(const fbtft_ingest_result_t *result, int per_file);
+
+#endif /* _FBTFT_INGEST_H_ */
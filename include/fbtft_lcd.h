@@ -26,6 +26,33 @@
 #define FBTFT_CYAN          0x07FF
 #define FBTFT_MAGENTA       0xF81F
 
+// 矩形区域 (像素坐标，w/h 为宽高)
+typedef struct {
+    int x;
+    int y;
+    int w;
+    int h;
+} fbtft_rect_t;
+
+// 每帧最多跟踪的脏矩形数量，超出后与代价最小的矩形合并
+#define FBTFT_MAX_DAMAGE_RECTS  16
+
+// 脏区域列表
+typedef struct {
+    fbtft_rect_t rects[FBTFT_MAX_DAMAGE_RECTS];
+    int count;
+} fbtft_damage_t;
+
+// 脏区域刷新统计
+typedef struct {
+    unsigned long long frames;          // 提交的帧数
+    unsigned long long full_frames;     // 整帧提交的次数
+    unsigned long long rects;           // 累计复制的矩形数
+    unsigned long long pixels;          // 累计复制的像素数
+    unsigned int last_rects;            // 最近一帧复制的矩形数
+    unsigned int last_pixels;           // 最近一帧复制的像素数
+} fbtft_damage_stats_t;
+
 // FBTFT LCD 结构体
 typedef struct {
     int fb_fd;                          // framebuffer文件描述符
@@ -37,8 +64,17 @@ typedef struct {
     int height;                         // 屏幕高度
     int bpp;                            // 每像素位数
     char device_path[256];              // 设备路径
+    fbtft_damage_stats_t damage_stats;  // 脏区域刷新统计
+    int num_buffers;                    // 缓冲页数量 (1 = 单缓冲)
+    int front_buffer;                   // 当前显示的页
+    int back_buffer;                    // 当前绘制的页
+    int page_flip;                      // 是否通过FBIOPAN_DISPLAY翻页 (0 = 复制模式)
+    uint16_t *shadow_buffer;            // 复制模式下的后台缓冲区
 } fbtft_lcd_t;
 
+// 多缓冲支持的最大页数
+#define FBTFT_MAX_BUFFERS   3
+
 // 函数声明
 int fbtft_lcd_init(fbtft_lcd_t *lcd, const char *device_path);
 void fbtft_lcd_deinit(fbtft_lcd_t *lcd);
@@ -48,8 +84,25 @@ int fbtft_lcd_set_pixel(fbtft_lcd_t *lcd, int x, int y, uint16_t color);
 uint16_t fbtft_lcd_get_pixel(fbtft_lcd_t *lcd, int x, int y);
 int fbtft_lcd_draw_rectangle(fbtft_lcd_t *lcd, int x1, int y1, int x2, int y2, uint16_t color);
 int fbtft_lcd_fill_rectangle(fbtft_lcd_t *lcd, int x1, int y1, int x2, int y2, uint16_t color);
+int fbtft_lcd_fill_rectangles(fbtft_lcd_t *lcd, const fbtft_rect_t *rects, int count, uint16_t color);
 int fbtft_lcd_sync(fbtft_lcd_t *lcd);
 
+// 脏区域刷新函数 (只把变化的矩形复制到framebuffer)
+void fbtft_damage_reset(fbtft_damage_t *damage);
+int fbtft_damage_add(fbtft_damage_t *damage, int x, int y, int w, int h);
+int fbtft_lcd_display_region(fbtft_lcd_t *lcd, const uint16_t *buffer, int x, int y, int w, int h);
+int fbtft_lcd_display_damage(fbtft_lcd_t *lcd, const uint16_t *buffer, const fbtft_damage_t *damage);
+int fbtft_lcd_display_strided(fbtft_lcd_t *lcd, const uint16_t *buffer, int stride, 
+                              const fbtft_damage_t *damage);
+void fbtft_lcd_get_damage_stats(const fbtft_lcd_t *lcd, fbtft_damage_stats_t *stats);
+void fbtft_lcd_reset_damage_stats(fbtft_lcd_t *lcd);
+
+// 多缓冲翻页函数 (yres_virtual = N * yres，通过FBIOPAN_DISPLAY切换显示页)
+int fbtft_lcd_enable_multibuffer(fbtft_lcd_t *lcd, int num_buffers);
+uint16_t *fbtft_lcd_get_back_buffer(fbtft_lcd_t *lcd);
+int fbtft_lcd_get_stride(const fbtft_lcd_t *lcd);
+int fbtft_lcd_flip(fbtft_lcd_t *lcd);
+
 // 电源管理定义
 #define FBTFT_LCD_POWER_ON      0   // 显示开启
 #define FBTFT_LCD_POWER_OFF     1   // 显示关闭
@@ -94,4 +147,12 @@ void fbtft_lcd_transform_buffer(uint16_t *src, uint16_t *dst, int width, int hei
 int fbtft_lcd_auto_fit_buffer(fbtft_lcd_t *lcd, const uint16_t *src_buffer, 
                              int src_width, int src_height);
 
+// 旋转/镜像后直接写入framebuffer，不经过中间缓冲区
+// width x height 为变换前的尺寸 (变换后必须与屏幕尺寸一致)，stride 为每行像素数
+// damage 为变换前坐标系中的脏矩形，为NULL时提交整帧
+int fbtft_lcd_present_transformed(fbtft_lcd_t *lcd, const uint16_t *buffer, 
+                                  int width, int height, int stride, 
+                                  rotation_t rotation, mirror_t mirror, 
+                                  const fbtft_rect_t *damage);
+
 #endif /* _FBTFT_LCD_H_ */
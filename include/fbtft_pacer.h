@@ -0,0 +1,46 @@
+#ifndef _FBTFT_PACER_H_
+#define _FBTFT_PACER_H_
+
+#include "fbtft_lcd.h"
+#include <time.h>
+
+// 启用垂直同步时，提前唤醒的时间余量 (纳秒)
+#define FBTFT_PACER_VSYNC_MARGIN_NS  2000000LL
+
+// 帧调度器：按固定目标帧率提交帧
+typedef struct {
+    int fb_fd;                          // framebuffer文件描述符 (用于FBIO_WAITFORVSYNC)
+    int use_vsync;                      // 驱动是否支持FBIO_WAITFORVSYNC
+    double target_fps;                  // 目标帧率
+    long long interval_ns;              // 帧间隔 (纳秒)
+    long long next_deadline_ns;         // 下一帧的截止时间 (CLOCK_MONOTONIC)
+    long long last_present_ns;          // 上一帧的实际提交时间
+    // 统计
+    unsigned long long frames;          // 已调度的帧数
+    unsigned long long missed;          // 错过截止时间的帧数
+    long long jitter_sum_ns;            // 提交时间偏差累计
+    long long jitter_max_ns;            // 最大提交时间偏差
+    long long interval_sum_ns;          // 实际帧间隔累计
+} fbtft_pacer_t;
+
+// 帧调度统计
+typedef struct {
+    unsigned long long frames;          // 已调度的帧数
+    unsigned long long missed;          // 错过截止时间的帧数
+    double avg_jitter_us;               // 平均提交时间偏差 (微秒)
+    double max_jitter_us;               // 最大提交时间偏差 (微秒)
+    double avg_interval_ms;             // 平均实际帧间隔 (毫秒)
+    double effective_fps;               // 实际帧率
+    int vsync;                          // 是否使用了垂直同步
+} fbtft_pacer_stats_t;
+
+// 函数声明
+long long fbtft_pacer_now_ns(void);
+int fbtft_pacer_init(fbtft_pacer_t *pacer, fbtft_lcd_t *lcd, double target_fps);
+int fbtft_pacer_set_target(fbtft_pacer_t *pacer, double target_fps);
+int fbtft_pacer_wait(fbtft_pacer_t *pacer);
+void fbtft_pacer_get_stats(const fbtft_pacer_t *pacer, fbtft_pacer_stats_t *stats);
+void fbtft_pacer_reset_stats(fbtft_pacer_t *pacer);
+void fbtft_pacer_print_stats(const fbtft_pacer_t *pacer);
+
+#endif /* _FBTFT_PACER_H_ */
@@ -0,0 +1,87 @@
+#ifndef _FBTFT_PLAYLIST_H_
+#define _FBTFT_PLAYLIST_H_
+
+#include "fbtft_lcd.h"
+#include "bmp_loader.h"
+#include "fbtft_image_cache.h"
+#include <pthread.h>
+
+// 播放列表预取
+// 解码线程按顺序把后面的 depth 张图片解码、适配到预先分配的缓冲区环中，
+// 显示当前图片的同时准备下一张，文件读取和格式转换不再占用每帧的关键路径
+
+// 预取深度上限
+#define FBTFT_PLAYLIST_MAX_DEPTH        8
+#define FBTFT_PLAYLIST_DEFAULT_DEPTH    2
+
+// 播放列表配置
+typedef struct {
+    int depth;                          // 预取深度 (1 ~ FBTFT_PLAYLIST_MAX_DEPTH)
+    int width;                          // 帧宽度 (旋转后，即屏幕宽度)
+    int height;                         // 帧高度 (旋转后)
+    fit_mode_t fit;                     // 适配模式
+    rotation_t rotation;                // 解码时把帧旋转到的方向，帧可以直接提交
+    int loop;                           // 播放到末尾后从头开始
+    fbtft_image_cache_t *cache;         // 已适配帧缓存 (可为NULL，此时每次都完整解码)
+} fbtft_playlist_config_t;
+
+// 预取好的一帧
+typedef struct {
+    uint16_t *pixels;                   // 帧数据 (行距等于宽度)
+    int index;                          // 在播放列表中的序号
+    int status;                         // 解码成功为0，失败为-1
+    long long decode_ns;                // 解码和适配耗时
+} fbtft_playlist_frame_t;
+
+// 播放列表
+typedef struct {
+    char **paths;                       // 图片路径 (复制)
+    int count;                          // 图片数量
+    fbtft_playlist_config_t config;
+    pthread_t thread;
+    int running;
+    pthread_mutex_t lock;               // 保护以下计数
+    pthread_cond_t ready_cond;          // 解码线程 -> 显示线程：有新帧
+    pthread_cond_t free_cond;           // 显示线程 -> 解码线程：有空闲缓冲区
+    int slot_count;                     // 缓冲区数量 = 预取深度 + 1 (正在显示的一帧)
+    fbtft_playlist_frame_t slots[FBTFT_PLAYLIST_MAX_DEPTH + 1];
+    // 计数只用于相减 (计数回绕后差值仍然正确)，缓冲区序号单独按 slot_count 回绕
+    unsigned int produced;              // 解码完成的帧数
+    unsigned int acquired;              // 显示线程取走的帧数
+    unsigned int released;              // 显示线程归还的帧数
+    int produce_slot;                   // 解码线程下一个写入的缓冲区
+    int acquire_slot;                   // 显示线程下一个取走的缓冲区
+    int holding;                        // 显示线程是否持有一帧
+    int next_index;                     // 解码线程下一张图片的序号
+    int finished;                       // 不循环时所有图片都已解码
+    // 统计
+    unsigned long long frames;          // 取走的帧数
+    unsigned long long failed;          // 解码失败的帧数
+    unsigned long long stalls;          // 需要等待解码线程的次数
+    long long stall_ns_sum;             // 等待解码线程的总时间
+    long long stall_ns_max;             // 单次最长等待时间
+    long long decode_ns_sum;            // 解码总耗时
+    unsigned long long ready_sum;       // 取帧时已预取好的帧数之和
+} fbtft_playlist_t;
+
+// 播放列表统计
+typedef struct {
+    unsigned long long frames;          // 取走的帧数
+    unsigned long long failed;          // 解码失败的帧数
+    unsigned long long stalls;          // 取帧时解码线程还没准备好的次数
+    double stall_ms_total;              // 等待解码线程的总时间 (毫秒)
+    double stall_ms_max;                // 单次最长等待时间 (毫秒)
+    double avg_decode_ms;               // 平均每帧解码耗时 (毫秒)
+    double avg_ready;                   // 取帧时平均已预取好的帧数
+    int depth;                          // 预取深度
+} fbtft_playlist_stats_t;
+
+// 函数声明
+int fbtft_playlist_start(fbtft_playlist_t *playlist, const char *const *paths, int count,
+                         const fbtft_playlist_config_t *config);
+const fbtft_playlist_frame_t *fbtft_playlist_next(fbtft_playlist_t *playlist);
+void fbtft_playlist_stop(fbtft_playlist_t *playlist);
+void fbtft_playlist_get_stats(fbtft_playlist_t *playlist, fbtft_playlist_stats_t *stats);
+void fbtft_playlist_print_stats(fbtft_playlist_t *playlist);
+
+#endif /* _FBTFT_PLAYLIST_H_ */
@@ -0,0 +1,45 @@
+#ifndef _FBTFT_POOL_H_
+#define _FBTFT_POOL_H_
+
+#include <stddef.h>
+
+// 库内共享的缓冲区池
+// 解码、适配和旋转过程中的临时帧和行缓冲区都从这里取，用完后按规格挂回空闲链表，
+// 下一帧直接复用；稳定播放时不再向堆申请内存 (heap_allocs 计数不再增长)
+
+// 返回的内存按该字节数对齐
+#define FBTFT_POOL_ALIGN            64
+
+// 规格数量：64, 96, 128, 192, 256 ... (每个2的幂之间再插一个1.5倍的规格)
+// 最大规格为 64 << (FBTFT_POOL_CLASSES / 2 - 1)，更大的请求直接向堆申请
+#define FBTFT_POOL_CLASSES          44
+
+// 空闲链表默认最多保留的字节数，超出后归还给堆
+#define FBTFT_POOL_DEFAULT_IDLE     (8 * 1024 * 1024)
+
+// 缓冲区池统计
+typedef struct {
+    unsigned long long requests;        // 分配请求次数
+    unsigned long long reuses;          // 从空闲链表复用的次数
+    unsigned long long heap_allocs;     // 实际向堆申请内存的次数
+    unsigned long long heap_frees;      // 实际归还给堆的次数
+    size_t in_use_bytes;                // 正在使用的内存 (按规格计)
+    size_t idle_bytes;                  // 空闲链表中的内存
+    size_t idle_limit;                  // 空闲链表最多保留的内存
+} fbtft_pool_stats_t;
+
+// 分配和归还 (bytes为0时返回NULL)
+void *fbtft_pool_alloc(size_t bytes);
+void *fbtft_pool_calloc(size_t bytes);
+void fbtft_pool_free(void *ptr);
+
+// 设置空闲链表最多保留的内存，并立即归还超出的部分
+void fbtft_pool_set_idle_limit(size_t bytes);
+// 把空闲链表中的内存全部归还给堆
+void fbtft_pool_trim(void);
+
+// 统计
+void fbtft_pool_get_stats(fbtft_pool_stats_t *stats);
+void fbtft_pool_reset_stats(void);
+
+#endif /* _FBTFT_POOL_H_ */
@@ -0,0 +1,85 @@
+#ifndef _FBTFT_PRESENTER_H_
+#define _FBTFT_PRESENTER_H_
+
+#include "fbtft_lcd.h"
+#include "fbtft_pacer.h"
+#include <pthread.h>
+#include <semaphore.h>
+
+// 队列深度上限
+#define FBTFT_PRESENTER_MAX_DEPTH   8
+
+// 队列满时的处理策略
+typedef enum {
+    PRESENT_BLOCK = 0,          // 等待空闲缓冲区和队列空位 (反压渲染线程)
+    PRESENT_DROP_NEW = 1,       // 没有空闲缓冲区时acquire返回NULL，队列满时submit拒绝新帧
+    PRESENT_LATEST = 2          // 队列满时用新帧替换最旧的待显示帧，渲染线程从不等待
+} present_policy_t;
+
+// 异步显示配置
+typedef struct {
+    int depth;                  // 待显示帧队列深度 (1 ~ FBTFT_PRESENTER_MAX_DEPTH)
+    present_policy_t policy;    // 队列满时的处理策略
+    int sync;                   // 每帧显示后调用fbtft_lcd_sync
+    double target_fps;          // 显示线程的目标帧率 (0 = 不限制)
+} fbtft_presenter_config_t;
+
+// 单生产者无锁环形队列 (出队用CAS，渲染线程可以取回最旧的帧)
+typedef struct {
+    uint16_t *slots[FBTFT_PRESENTER_MAX_DEPTH * 2]; // 容量最大为 深度+2，取2的幂后不超过该大小
+    unsigned int capacity;      // 有效容量
+    unsigned int mask;          // 槽号掩码 (槽数为2的幂)
+    unsigned int head;          // 写入计数 (生产者)
+    unsigned int tail;          // 读取计数 (消费者)
+} fbtft_spsc_queue_t;
+
+// 异步显示器
+typedef struct {
+    fbtft_lcd_t *lcd;                   // 运行期间由显示线程独占
+    fbtft_presenter_config_t config;
+    pthread_t thread;
+    int running;
+    int buffer_count;                   // 缓冲区数量 = 队列深度 + 2
+    uint16_t *buffers[FBTFT_PRESENTER_MAX_DEPTH + 2];
+    uint16_t *spare[FBTFT_PRESENTER_MAX_DEPTH + 2]; // 渲染线程归还或被替换下来的缓冲区 (栈)
+    int spare_count;
+    fbtft_spsc_queue_t ready_queue;     // 渲染线程 -> 显示线程 (容量为队列深度)
+    fbtft_spsc_queue_t free_queue;      // 显示线程 -> 渲染线程 (回收的缓冲区)
+    sem_t ready_sem;
+    sem_t free_sem;
+    sem_t slot_sem;                     // 待显示队列的空位数 (初始为队列深度)
+    fbtft_pacer_t pacer;
+    int paced;
+    // 统计 (渲染线程写入)
+    unsigned long long submitted;
+    unsigned long long dropped_acquire;
+    unsigned long long occupancy_sum;
+    unsigned int occupancy_max;
+    // 统计 (显示线程写入，dropped_stale 两个线程都会原子累加)
+    unsigned long long presented;
+    unsigned long long dropped_stale;
+    unsigned long long present_ns_sum;
+} fbtft_presenter_t;
+
+// 异步显示统计
+typedef struct {
+    unsigned long long submitted;       // 提交的帧数
+    unsigned long long presented;       // 实际显示的帧数
+    unsigned long long dropped;         // 丢弃的帧数
+    unsigned int queue_depth;           // 队列深度
+    unsigned int queue_occupancy;       // 当前待显示帧数
+    unsigned int queue_max;             // 提交时观察到的最大待显示帧数
+    double queue_avg;                   // 提交时的平均待显示帧数
+    double avg_present_ms;              // 平均每帧显示耗时 (毫秒)
+} fbtft_presenter_stats_t;
+
+// 函数声明
+int fbtft_presenter_start(fbtft_presenter_t *presenter, fbtft_lcd_t *lcd, 
+                          const fbtft_presenter_config_t *config);
+uint16_t *fbtft_presenter_acquire(fbtft_presenter_t *presenter);
+int fbtft_presenter_submit(fbtft_presenter_t *presenter, uint16_t *buffer);
+void fbtft_presenter_release(fbtft_presenter_t *presenter, uint16_t *buffer);
+void fbtft_presenter_stop(fbtft_presenter_t *presenter);
+void fbtft_presenter_get_stats(const fbtft_presenter_t *presenter, fbtft_presenter_stats_t *stats);
+
+#endif /* _FBTFT_PRESENTER_H_ */
@@ -0,0 +1,93 @@
+#ifndef _FBTFT_SCALER_H_
+#define _FBTFT_SCALER_H_
+
+#include "fbtft_lcd.h"
+
+// RGB565图像缩放引擎 (16.16定点坐标，内循环中没有浮点运算和除法)
+
+// 插值方式
+typedef enum {
+    SCALE_NEAREST = 0,      // 最近邻
+    SCALE_BILINEAR = 1,     // 双线性 (RGB565各通道分别插值)
+    SCALE_BOX = 2           // 区域平均 (适合缩小)
+} scale_filter_t;
+
+// 适配策略
+typedef enum {
+    SCALE_LETTERBOX = 0,    // 保持宽高比完整显示，空白部分填充背景色
+    SCALE_STRETCH = 1,      // 拉伸填满目标区域
+    SCALE_CROP_FILL = 2     // 保持宽高比填满目标区域，裁掉超出的部分
+} scale_policy_t;
+
+// 缓存的坐标表数量 (每组 源尺寸/目标尺寸/插值方式/适配策略/旋转 占用一项)
+#define FBTFT_SCALE_CACHE_ENTRIES   8
+
+// 坐标表缓存统计
+typedef struct {
+    unsigned long long hits;            // 命中次数
+    unsigned long long misses;          // 未命中次数 (需要重新计算坐标表)
+    unsigned long long evictions;       // 被淘汰的表数量
+    int entries;                        // 当前缓存的表数量
+    size_t bytes;                       // 当前缓存占用的内存
+} fbtft_scale_cache_stats_t;
+
+// 流式缩小器：源图像按存储顺序逐行送入，只保留一两行的中间结果，
+// 不需要完整的源图像 (用于远大于屏幕的图片)
+typedef struct {
+    int src_width;                      // 源图像宽度
+    int src_height;                     // 源图像高度
+    int bottom_up;                      // 源行是否自下而上送入
+    fbtft_rect_t src_rect;              // 适配后的源矩形
+    fbtft_rect_t dst_rect;              // 适配后的目标矩形
+    scale_filter_t filter;              // 插值方式
+    uint16_t *dst;                      // 目标缓冲区
+    size_t dst_stride;                  // 目标每行字节数
+    int32_t *x_index;                   // 水平坐标表 (区域平均时为dst_w+1个边界)
+    int32_t *y_index;                   // 垂直坐标表 (区域平均时为dst_h+1个边界)
+    uint8_t *x_weight;                  // 双线性水平权重
+    uint8_t *y_weight;                  // 双线性垂直权重
+    uint8_t *row_needed;                // 源矩形中每一行是否会被用到
+    uint16_t *hrows[2];                 // 双线性：按源行奇偶保存的两行水平插值结果 (BGR)
+    uint32_t *acc;                      // 区域平均：当前目标行的通道累加值 (BGR)
+    int acc_rows;                       // 区域平均：已累加的源行数
+    int next_row;                       // 下一个送入的行 (存储顺序)
+    int next_dst;                       // 下一个输出的目标行
+    void *block;                        // 以上各表共用的内存块
+} fbtft_scale_stream_t;
+
+// 按适配策略计算源矩形和目标矩形
+void fbtft_scale_fit(int src_width, int src_height, int dst_width, int dst_height,
+                     scale_policy_t policy, fbtft_rect_t *src_rect, fbtft_rect_t *dst_rect);
+
+// 把源图像中的 src_rect 缩放到目标的 dst_rect (行距均为每行像素数)
+int fbtft_scale_rect(const uint16_t *src, int src_stride, const fbtft_rect_t *src_rect,
+                     uint16_t *dst, int dst_stride, const fbtft_rect_t *dst_rect,
+                     scale_filter_t filter);
+
+// 按适配策略把整幅源图像缩放到目标缓冲区，letterbox的空白部分填充 bg_color
+int fbtft_scale_rgb565(const uint16_t *src, int src_width, int src_height, int src_stride,
+                       uint16_t *dst, int dst_width, int dst_height, int dst_stride,
+                       scale_filter_t filter, scale_policy_t policy, uint16_t bg_color);
+
+// 缩放的同时旋转/镜像 (源尺寸为旋转前的尺寸)，不需要中间缓冲区
+int fbtft_scale_rgb565_transformed(const uint16_t *src, int src_width, int src_height, int src_stride,
+                                   uint16_t *dst, int dst_width, int dst_height, int dst_stride,
+                                   scale_filter_t filter, scale_policy_t policy, uint16_t bg_color,
+                                   rotation_t rotation, mirror_t mirror);
+
+// 流式缩小：bytes_per_pixel 为3 (BGR) 或4 (BGRA)，区域平均要求两个方向都是缩小
+int fbtft_scale_stream_init(fbtft_scale_stream_t *stream, int src_width, int src_height, int bottom_up,
+                            uint16_t *dst, int dst_width, int dst_height, int dst_stride,
+                            scale_filter_t filter, scale_policy_t policy, uint16_t bg_color);
+int fbtft_scale_stream_row_needed(const fbtft_scale_stream_t *stream);
+void fbtft_scale_stream_push_row(fbtft_scale_stream_t *stream, const uint8_t *row, int bytes_per_pixel);
+void fbtft_scale_stream_destroy(fbtft_scale_stream_t *stream);
+
+// 坐标表缓存管理
+int fbtft_scale_cache_prewarm(int src_width, int src_height, int dst_width, int dst_height,
+                              scale_filter_t filter, scale_policy_t policy, rotation_t rotation);
+void fbtft_scale_cache_evict(void);
+void fbtft_scale_cache_get_stats(fbtft_scale_cache_stats_t *stats);
+void fbtft_scale_cache_reset_stats(void);
+
+#endif /* _FBTFT_SCALER_H_ */
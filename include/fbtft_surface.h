@@ -0,0 +1,49 @@
+#ifndef _FBTFT_SURFACE_H_
+#define _FBTFT_SURFACE_H_
+
+#include "fbtft_lcd.h"
+
+// 5x7点阵字体的字符尺寸 (含1像素字间距)
+#define FBTFT_FONT_WIDTH    6
+#define FBTFT_FONT_HEIGHT   7
+
+// RGB565绘图表面
+// 可以包装malloc分配的缓冲区、framebuffer页或另一个表面的子矩形视图；
+// 所有绘图函数都只写入裁剪矩形以内的像素
+typedef struct {
+    uint16_t *pixels;           // 左上角像素地址
+    int width;                  // 宽度
+    int height;                 // 高度
+    int stride;                 // 每行像素数 (>= width)
+    fbtft_rect_t clip;          // 裁剪矩形 (表面坐标)
+    int owns_pixels;            // 是否由表面负责释放像素内存
+} fbtft_surface_t;
+
+// 创建和释放
+int fbtft_surface_create(fbtft_surface_t *surface, int width, int height);
+int fbtft_surface_wrap(fbtft_surface_t *surface, uint16_t *pixels, int width, int height, int stride);
+int fbtft_surface_wrap_lcd(fbtft_surface_t *surface, fbtft_lcd_t *lcd);
+int fbtft_surface_sub(fbtft_surface_t *view, const fbtft_surface_t *parent, int x, int y, int w, int h);
+void fbtft_surface_destroy(fbtft_surface_t *surface);
+
+// 裁剪矩形
+void fbtft_surface_set_clip(fbtft_surface_t *surface, int x, int y, int w, int h);
+void fbtft_surface_reset_clip(fbtft_surface_t *surface);
+
+// 绘图函数
+void fbtft_surface_clear(fbtft_surface_t *surface, uint16_t color);
+void fbtft_surface_set_pixel(fbtft_surface_t *surface, int x, int y, uint16_t color);
+uint16_t fbtft_surface_get_pixel(const fbtft_surface_t *surface, int x, int y);
+void fbtft_surface_fill_rect(fbtft_surface_t *surface, int x, int y, int w, int h, uint16_t color);
+void fbtft_surface_draw_rect(fbtft_surface_t *surface, int x, int y, int w, int h, uint16_t color);
+void fbtft_surface_blit(fbtft_surface_t *dst, int dst_x, int dst_y, 
+                        const fbtft_surface_t *src, int src_x, int src_y, int w, int h);
+void fbtft_surface_draw_text(fbtft_surface_t *surface, int x, int y, const char *text, 
+                             uint16_t color, uint16_t bg_color);
+void fbtft_surface_draw_text_vertical(fbtft_surface_t *surface, int x, int y, const char *text, 
+                                      uint16_t color, uint16_t bg_color);
+
+// 显示到LCD (表面尺寸必须与屏幕相同)
+int fbtft_surface_present(const fbtft_surface_t *surface, fbtft_lcd_t *lcd, const fbtft_damage_t *damage);
+
+#endif /* _FBTFT_SURFACE_H_ */
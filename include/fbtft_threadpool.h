@@ -0,0 +1,30 @@
+#ifndef _FBTFT_THREADPOOL_H_
+#define _FBTFT_THREADPOOL_H_
+
+#include <stddef.h>
+
+// 库内共享的常驻线程池，按水平条带并行处理逐行独立的像素运算
+// 默认单线程：不创建任何线程，所有运算直接在调用线程中完成
+
+// 最大线程数 (含调用线程)
+#define FBTFT_THREADPOOL_MAX_THREADS    16
+
+// 每个条带的目标字节数，使条带的工作集能留在L1/L2缓存中
+#define FBTFT_PARALLEL_BAND_BYTES       (16 * 1024)
+
+// 总数据量小于该值时不值得唤醒工作线程，直接在调用线程中完成
+#define FBTFT_PARALLEL_MIN_BYTES        (64 * 1024)
+
+// 条带处理函数：处理 [begin, end) 范围内的行
+typedef void (*fbtft_band_fn_t)(void *ctx, int begin, int end);
+
+// 设置线程数 (含调用线程)，0表示按在线CPU核数自动选择，1表示单线程
+int fbtft_threadpool_set_threads(int num_threads);
+int fbtft_threadpool_get_threads(void);
+void fbtft_threadpool_shutdown(void);
+
+// 把 rows 行按条带分给线程池处理，row_bytes 为每行的数据量，用于决定条带大小
+// 返回时所有条带都已处理完成
+void fbtft_parallel_rows(int rows, size_t row_bytes, fbtft_band_fn_t fn, void *ctx);
+
+#endif /* _FBTFT_THREADPOOL_H_ */
@@ -1,143 +1,1063 @@
 #include "bmp_loader.h"
+#include "color_convert.h"
+#include "fbtft_lcd.h"
+#include "fbtft_scaler.h"
+#include "fbtft_threadpool.h"
+#include "fbtft_pool.h"
+#include "fbtft_blit.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// 压缩类型
+#define BMP_BI_RGB          0
+#define BMP_BI_RLE8         1
+#define BMP_BI_RLE4         2
+#define BMP_BI_BITFIELDS    3
+
+// RLE文件的像素数上限：数据长度不能限制解码后的尺寸 (位移和位图结束转义用几个字节就能跳过整幅图像)
+#define BMP_RLE_MAX_PIXELS  (32u * 1024 * 1024)
+
+// 文件中的像素格式
+typedef enum {
+    BMP_PIXEL_BGR888 = 0,       // 24位 BGR
+    BMP_PIXEL_BGRA8888,         // 32位 BGRA (忽略alpha)
+    BMP_PIXEL_RGB565,           // 16位 RGB565 (BI_BITFIELDS)，直接复制
+    BMP_PIXEL_RGB555,           // 16位 X1R5G5B5
+    BMP_PIXEL_INDEX8,           // 8位调色板
+    BMP_PIXEL_INDEX4,           // 4位调色板
+    BMP_PIXEL_INDEX1,           // 1位调色板
+    BMP_PIXEL_RLE8,             // 8位调色板，RLE压缩
+    BMP_PIXEL_RLE4              // 4位调色板，RLE压缩
+} bmp_pixel_format_t;
+
+// 映射到内存的BMP文件
+typedef struct {
+    void *map;                  // 整个文件的只读映射
+    size_t map_size;            // 映射长度 (文件大小)
+    BMPFileHeader file_header;  // 文件头 (从映射中复制，避免非对齐访问)
+    BMPInfoHeader info_header;  // 信息头
+    const uint8_t *pixels;      // 像素阵列在映射中的起始地址
+    int width;                  // 图像宽度
+    int height;                 // 图像高度 (绝对值)
+    int bpp;                    // 每像素位数
+    int bytes_per_pixel;        // 每像素字节数 (24/32位时有效，可直接送入流式缩小器)
+    int row_bytes;              // 文件中每行的字节数 (4字节对齐，RLE时为0)
+    size_t pixel_bytes;         // 像素数据的字节数
+    int is_bottom_up;           // 行是否自下而上存储
+    bmp_pixel_format_t format;  // 像素格式
+    uint16_t palette[256];      // 预先转换为RGB565的调色板
+} bmp_mapped_t;
+
+// 映射后对像素数据的访问方式
+typedef enum {
+    BMP_MAP_RANDOM = 0,         // 只访问文件头或局部区域，不提前读入
+    BMP_MAP_PREFETCH,           // 完整解码，提前读入整个文件
+    BMP_MAP_STREAM              // 流式缩小，只做顺序预读，不提前读入整个文件
+} bmp_map_access_t;
+
+// RLE解码时每解出一行调用一次，file_row 为该行在文件中的顺序
+typedef void (*bmp_row_sink_t)(void *ctx, int file_row, const uint16_t *row);
+
+static void bmp_unmap_file(bmp_mapped_t *bmp);
+
+// 像素转换任务 (按文件中的行分条带)
+typedef struct {
+    const bmp_mapped_t *bmp;    // 映射的文件
+    BMPImage *image;            // 输出图像
+} bmp_convert_job_t;
+
+// 区域解码任务
+typedef struct {
+    const bmp_mapped_t *bmp;    // 映射的文件
+    fbtft_rect_t rect;          // 图像坐标中的区域 (自上而下)
+    uint16_t *dst;              // 区域左上角对应的输出像素
+    int dst_stride;             // 输出每行像素数
+} bmp_region_job_t;
 
 /**
- * 加载BMP图像
+ * 把文件中第 file_row 行 (未压缩) 的 [x, x + count) 列转换为RGB565
+ * 只读取这些列所在的字节
  */
-int bmp_load(const char *filename, BMPImage *image) {
-    if (!filename || !image) {
-        fprintf(stderr, "Error: Invalid parameters\n");
+static void bmp_decode_span(const bmp_mapped_t *bmp, int file_row, int x, int count, uint16_t *dst) {
+    const uint8_t *row = bmp->pixels + (size_t)file_row * bmp->row_bytes;
+    
+    switch (bmp->format) {
+        case BMP_PIXEL_BGR888:
+            convert_row_bgr888_to_rgb565(dst, row + (size_t)x * 3, count);
+            break;
+        case BMP_PIXEL_BGRA8888:
+            convert_row_bgra8888_to_rgb565(dst, row + (size_t)x * 4, count);
+            break;
+        case BMP_PIXEL_RGB565:
+            // 与目标格式相同，直接复制
+            memcpy(dst, row + (size_t)x * 2, (size_t)count * sizeof(uint16_t));
+            break;
+        case BMP_PIXEL_RGB555:
+            convert_row_rgb555_to_rgb565(dst, row + (size_t)x * 2, count);
+            break;
+        case BMP_PIXEL_INDEX8:
+            convert_row_index8_to_rgb565(dst, row + x, count, bmp->palette);
+            break;
+        case BMP_PIXEL_INDEX4:
+            row += x / 2;
+            // 从字节中间开始时先处理低4位
+            if ((x & 1) && count > 0) {
+                *dst++ = bmp->palette[*row++ & 0x0F];
+                count--;
+            }
+            convert_row_index4_to_rgb565(dst, row, count, bmp->palette);
+            break;
+        case BMP_PIXEL_INDEX1:
+            row += x / 8;
+            // 先处理起始字节中剩余的位
+            if (x & 7) {
+                for (int bit = x & 7; bit < 8 && count > 0; bit++, count--) {
+                    *dst++ = bmp->palette[(*row >> (7 - bit)) & 1];
+                }
+                row++;
+            }
+            convert_row_index1_to_rgb565(dst, row, count, bmp->palette);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * 把文件中的第 file_row 行 (未压缩) 转换为RGB565
+ */
+static void bmp_decode_row(const bmp_mapped_t *bmp, int file_row, uint16_t *dst) {
+    bmp_decode_span(bmp, file_row, 0, bmp->width, dst);
+}
+
+/**
+ * 把文件中的 [begin, end) 行转换为RGB565
+ */
+static void bmp_convert_band(void *ctx, int begin, int end) {
+    const bmp_convert_job_t *job = (const bmp_convert_job_t *)ctx;
+    const bmp_mapped_t *bmp = job->bmp;
+    BMPImage *image = job->image;
+    
+    for (int y = begin; y < end; y++) {
+        // 计算目标行索引
+        int dst_y = bmp->is_bottom_up ? (image->height - 1 - y) : y;
+        bmp_decode_row(bmp, y, image->data + (size_t)dst_y * image->width);
+    }
+}
+
+/**
+ * 把区域中的 [begin, end) 行转换为RGB565
+ */
+static void bmp_region_band(void *ctx, int begin, int end) {
+    const bmp_region_job_t *job = (const bmp_region_job_t *)ctx;
+    const bmp_mapped_t *bmp = job->bmp;
+    
+    for (int j = begin; j < end; j++) {
+        // 自下而上存储时区域的第一行在文件中靠后
+        int y = job->rect.y + j;
+        int file_row = bmp->is_bottom_up ? (bmp->height - 1 - y) : y;
+        bmp_decode_span(bmp, file_row, job->rect.x, job->rect.w, job->dst + (size_t)j * job->dst_stride);
+    }
+}
+
+/**
+ * 用调色板第0项填充一行 (RLE中被跳过的像素)
+ */
+static void rle_clear_row(const bmp_mapped_t *bmp, uint16_t *row) {
+    for (int x = 0; x < bmp->width; x++) {
+        row[x] = bmp->palette[0];
+    }
+}
+
+/**
+ * 顺序解码RLE8/RLE4像素数据，每完成一行交给 sink
+ * 数据提前结束或损坏时，剩余的行按调色板第0项输出
+ * @param row 一行的临时缓冲区
+ */
+static void bmp_decode_rle(const bmp_mapped_t *bmp, uint16_t *row, bmp_row_sink_t sink, void *ctx) {
+    const uint8_t *p = bmp->pixels;
+    const uint8_t *end = bmp->pixels + bmp->pixel_bytes;
+    int rle4 = (bmp->format == BMP_PIXEL_RLE4);
+    int width = bmp->width;
+    int x = 0, y = 0;
+    
+    rle_clear_row(bmp, row);
+    
+    while (y < bmp->height && end - p >= 2) {
+        int count = p[0];
+        int value = p[1];
+        p += 2;
+        
+        if (count > 0) {
+            // 编码模式：重复 count 个像素 (RLE4时两个索引交替)
+            uint16_t c0 = bmp->palette[rle4 ? (value >> 4) : value];
+            uint16_t c1 = rle4 ? bmp->palette[value & 0x0F] : c0;
+            for (int i = 0; i < count && x < width; i++, x++) {
+                row[x] = (i & 1) ? c1 : c0;
+            }
+        } else if (value == 0) {
+            // 行结束
+            sink(ctx, y++, row);
+            rle_clear_row(bmp, row);
+            x = 0;
+        } else if (value == 1) {
+            // 位图结束
+            break;
+        } else if (value == 2) {
+            // 位移：向右 dx，向上 dy 行
+            if (end - p < 2) break;
+            int dx = p[0], dy = p[1];
+            p += 2;
+            for (int i = 0; i < dy && y < bmp->height; i++) {
+                sink(ctx, y++, row);
+                rle_clear_row(bmp, row);
+            }
+            x += dx;
+        } else {
+            // 绝对模式：value 个未压缩的索引，按2字节对齐
+            int bytes = rle4 ? (value + 1) / 2 : value;
+            if (end - p < bytes) break;
+            for (int i = 0; i < value && x < width; i++, x++) {
+                int index = rle4 ? ((i & 1) ? (p[i / 2] & 0x0F) : (p[i / 2] >> 4)) : p[i];
+                row[x] = bmp->palette[index];
+            }
+            p += (bytes + 1) & ~1;
+        }
+    }
+    
+    // 输出剩余的行
+    while (y < bmp->height) {
+        sink(ctx, y++, row);
+        rle_clear_row(bmp, row);
+    }
+}
+
+/**
+ * RLE解码输出：写入完整图像的对应行
+ */
+static void rle_image_sink(void *ctx, int file_row, const uint16_t *row) {
+    BMPImage *image = (BMPImage *)ctx;
+    int dst_y = image->height - 1 - file_row; // RLE总是自下而上存储
+    memcpy(image->data + (size_t)dst_y * image->width, row, (size_t)image->width * sizeof(uint16_t));
+}
+
+/**
+ * RLE解码输出：只复制落在区域内的行和列
+ */
+static void rle_region_sink(void *ctx, int file_row, const uint16_t *row) {
+    const bmp_region_job_t *job = (const bmp_region_job_t *)ctx;
+    int y = job->bmp->height - 1 - file_row;
+    
+    if (y < job->rect.y || y >= job->rect.y + job->rect.h) return;
+    memcpy(job->dst + (size_t)(y - job->rect.y) * job->dst_stride, row + job->rect.x, 
+           (size_t)job->rect.w * sizeof(uint16_t));
+}
+
+/**
+ * 读取BI_BITFIELDS的红、绿、蓝掩码
+ * 信息头为40字节时掩码紧跟在信息头之后，V4/V5信息头中位于相同的位置
+ */
+static int bmp_read_masks(const bmp_mapped_t *bmp, uint32_t masks[3]) {
+    size_t offset = sizeof(BMPFileHeader) + sizeof(BMPInfoHeader);
+    if (offset + 3 * sizeof(uint32_t) > bmp->map_size) {
+        return -1;
+    }
+    memcpy(masks, (const uint8_t *)bmp->map + offset, 3 * sizeof(uint32_t));
+    return 0;
+}
+
+/**
+ * 按位深和压缩类型确定像素格式
+ */
+static int bmp_detect_format(bmp_mapped_t *bmp) {
+    uint32_t compression = bmp->info_header.biCompression;
+    uint32_t masks[3];
+    int bpp = bmp->bpp;
+    
+    bmp->bytes_per_pixel = 0;
+    
+    if (bpp == 24 && compression == BMP_BI_RGB) {
+        bmp->format = BMP_PIXEL_BGR888;
+        bmp->bytes_per_pixel = 3;
+        return 0;
+    }
+    
+    if (bpp == 32 && compression == BMP_BI_RGB) {
+        bmp->format = BMP_PIXEL_BGRA8888;
+        bmp->bytes_per_pixel = 4;
+        return 0;
+    }
+    
+    if ((bpp == 16 || bpp == 32) && compression == BMP_BI_BITFIELDS) {
+        if (bmp_read_masks(bmp, masks) != 0) {
+            fprintf(stderr, "Error: Cannot read BMP bitfield masks\n");
+            return -1;
+        }
+        if (bpp == 16 && masks[0] == 0xF800 && masks[1] == 0x07E0 && masks[2] == 0x001F) {
+            bmp->format = BMP_PIXEL_RGB565;
+            return 0;
+        }
+        if (bpp == 16 && masks[0] == 0x7C00 && masks[1] == 0x03E0 && masks[2] == 0x001F) {
+            bmp->format = BMP_PIXEL_RGB555;
+            return 0;
+        }
+        if (bpp == 32 && masks[0] == 0x00FF0000 && masks[1] == 0x0000FF00 && masks[2] == 0x000000FF) {
+            bmp->format = BMP_PIXEL_BGRA8888;
+            bmp->bytes_per_pixel = 4;
+            return 0;
+        }
+        fprintf(stderr, "Error: Unsupported BMP bitfield masks %08X/%08X/%08X\n", 
+                masks[0], masks[1], masks[2]);
+        return -1;
+    }
+    
+    if (bpp == 16 && compression == BMP_BI_RGB) {
+        bmp->format = BMP_PIXEL_RGB555;
+        return 0;
+    }
+    
+    if (compression == BMP_BI_RGB && (bpp == 8 || bpp == 4 || bpp == 1)) {
+        bmp->format = (bpp == 8) ? BMP_PIXEL_INDEX8 : (bpp == 4) ? BMP_PIXEL_INDEX4 : BMP_PIXEL_INDEX1;
+        return 0;
+    }
+    
+    if ((bpp == 8 && compression == BMP_BI_RLE8) || (bpp == 4 && compression == BMP_BI_RLE4)) {
+        // RLE位图只能自下而上存储
+        if (!bmp->is_bottom_up) {
+            fprintf(stderr, "Error: Top-down RLE BMP files are not valid\n");
+            return -1;
+        }
+        bmp->format = (bpp == 8) ? BMP_PIXEL_RLE8 : BMP_PIXEL_RLE4;
+        return 0;
+    }
+    
+    fprintf(stderr, "Error: Unsupported BMP format (%d-bit, compression %u)\n", bpp, compression);
+    return -1;
+}
+
+/**
+ * 读取调色板并预先转换为RGB565 (1/4/8位)
+ * 调色板项数以外的索引映射为黑色
+ */
+static int bmp_load_palette(bmp_mapped_t *bmp) {
+    memset(bmp->palette, 0, sizeof(bmp->palette));
+    if (bmp->bpp > 8) return 0;
+    
+    uint32_t max_colors = 1u << bmp->bpp;
+    uint32_t colors = bmp->info_header.biClrUsed ? bmp->info_header.biClrUsed : max_colors;
+    if (colors > max_colors) colors = max_colors;
+    
+    // 调色板紧跟在信息头之后，每项为 B, G, R, 保留
+    size_t offset = sizeof(BMPFileHeader) + bmp->info_header.biSize;
+    if (offset + (size_t)colors * 4 > bmp->map_size) {
+        fprintf(stderr, "Error: Cannot read BMP palette\n");
         return -1;
     }
     
-    FILE *file = fopen(filename, "rb");
-    if (!file) {
+    const uint8_t *entry = (const uint8_t *)bmp->map + offset;
+    for (uint32_t i = 0; i < colors; i++, entry += 4) {
+        bmp->palette[i] = bgr_to_rgb565(entry[0], entry[1], entry[2]);
+    }
+    return 0;
+}
+
+/**
+ * 提前读入映射中 [offset, offset + length) 字节所在的页
+ */
+static void bmp_prefetch_range(const bmp_mapped_t *bmp, size_t offset, size_t length) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t begin = offset & ~(page - 1);
+    size_t end = offset + length;
+    
+    if (end > bmp->map_size) end = bmp->map_size;
+    if (begin >= end) return;
+    madvise((uint8_t *)bmp->map + begin, end - begin, MADV_WILLNEED);
+}
+
+/**
+ * 映射BMP文件并在映射内存上直接校验文件头
+ * 成功后 bmp->pixels 指向文件中的像素阵列
+ * @param access 像素数据的访问方式，决定是否提前读入整个文件
+ */
+static int bmp_map_file_ex(const char *filename, bmp_mapped_t *bmp, bmp_map_access_t access) {
+    memset(bmp, 0, sizeof(*bmp));
+    
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
         fprintf(stderr, "Error: Cannot open file %s\n", filename);
         return -1;
     }
     
-    BMPFileHeader file_header;
-    BMPInfoHeader info_header;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        perror("Error: Cannot stat BMP file");
+        close(fd);
+        return -1;
+    }
     
-    // 读取文件头
-    if (fread(&file_header, sizeof(BMPFileHeader), 1, file) != 1) {
+    if ((size_t)st.st_size < sizeof(BMPFileHeader) + sizeof(BMPInfoHeader)) {
         fprintf(stderr, "Error: Cannot read BMP file header\n");
-        fclose(file);
+        close(fd);
+        return -1;
+    }
+    
+    bmp->map_size = (size_t)st.st_size;
+    bmp->map = mmap(NULL, bmp->map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // 映射建立后即可关闭文件描述符
+    if (bmp->map == MAP_FAILED) {
+        perror("Error: Failed to mmap BMP file");
+        bmp->map = NULL;
         return -1;
     }
     
+    // 完整解码时顺序访问并提前读入，减少转换时的缺页等待；
+    // 流式缩小只靠内核的顺序预读，避免大文件一次性占满页缓存
+    if (access == BMP_MAP_PREFETCH) {
+        madvise(bmp->map, bmp->map_size, MADV_SEQUENTIAL);
+        madvise(bmp->map, bmp->map_size, MADV_WILLNEED);
+    } else if (access == BMP_MAP_STREAM) {
+        madvise(bmp->map, bmp->map_size, MADV_SEQUENTIAL);
+    } else {
+        madvise(bmp->map, bmp->map_size, MADV_RANDOM);
+    }
+    
+    const uint8_t *base = (const uint8_t *)bmp->map;
+    memcpy(&bmp->file_header, base, sizeof(BMPFileHeader));
+    memcpy(&bmp->info_header, base + sizeof(BMPFileHeader), sizeof(BMPInfoHeader));
+    
     // 检查BMP标识
-    if (file_header.bfType != 0x4D42) { // "BM"
+    if (bmp->file_header.bfType != 0x4D42) { // "BM"
         fprintf(stderr, "Error: Not a valid BMP file\n");
-        fclose(file);
+        bmp_unmap_file(bmp);
         return -1;
     }
     
-    // 读取信息头
-    if (fread(&info_header, sizeof(BMPInfoHeader), 1, file) != 1) {
-        fprintf(stderr, "Error: Cannot read BMP info header\n");
-        fclose(file);
+    if (bmp->info_header.biSize < sizeof(BMPInfoHeader)) {
+        fprintf(stderr, "Error: Unsupported BMP header size %u\n", bmp->info_header.biSize);
+        bmp_unmap_file(bmp);
         return -1;
     }
     
-    // 只支持24位和32位BMP
-    if (info_header.biBitCount != 24 && info_header.biBitCount != 32) {
-        fprintf(stderr, "Error: Only 24-bit and 32-bit BMP files are supported\n");
-        fclose(file);
+    if (bmp->info_header.biWidth <= 0 || bmp->info_header.biHeight == 0 || 
+        bmp->info_header.biHeight == INT32_MIN) {
+        fprintf(stderr, "Error: Invalid BMP dimensions\n");
+        bmp_unmap_file(bmp);
         return -1;
     }
     
-    // 不支持压缩
-    if (info_header.biCompression != 0) {
-        fprintf(stderr, "Error: Compressed BMP files are not supported\n");
-        fclose(file);
+    bmp->width = bmp->info_header.biWidth;
+    bmp->height = abs(bmp->info_header.biHeight);
+    bmp->bpp = bmp->info_header.biBitCount;
+    bmp->is_bottom_up = (bmp->info_header.biHeight > 0);
+    
+    if (bmp_detect_format(bmp) != 0 || bmp_load_palette(bmp) != 0) {
+        bmp_unmap_file(bmp);
         return -1;
     }
     
-    // 设置图像参数
-    image->width = info_header.biWidth;
-    image->height = abs(info_header.biHeight);
-    image->bpp = info_header.biBitCount;
+    if (bmp->file_header.bfOffBits >= bmp->map_size) {
+        fprintf(stderr, "Error: Cannot read pixel data\n");
+        bmp_unmap_file(bmp);
+        return -1;
+    }
+    bmp->pixels = base + bmp->file_header.bfOffBits;
+    
+    // RLE数据长度不固定，解码时逐字节检查边界
+    if (bmp->format == BMP_PIXEL_RLE8 || bmp->format == BMP_PIXEL_RLE4) {
+        if ((uint64_t)bmp->width * (uint64_t)bmp->height > BMP_RLE_MAX_PIXELS) {
+            fprintf(stderr, "Error: RLE BMP dimensions %dx%d are too large\n", bmp->width, bmp->height);
+            bmp_unmap_file(bmp);
+            return -1;
+        }
+        bmp->pixel_bytes = bmp->map_size - bmp->file_header.bfOffBits;
+        if (bmp->info_header.biSizeImage && bmp->info_header.biSizeImage < bmp->pixel_bytes) {
+            bmp->pixel_bytes = bmp->info_header.biSizeImage;
+        }
+        bmp->row_bytes = 0;
+        return 0;
+    }
     
     // 计算行的字节数（4字节对齐）
-    int bytes_per_pixel = info_header.biBitCount / 8;
-    int row_bytes = ((image->width * bytes_per_pixel + 3) / 4) * 4;
+    uint64_t row_bytes = (((uint64_t)bmp->width * bmp->bpp + 31) / 32) * 4;
+    uint64_t pixel_end = (uint64_t)bmp->file_header.bfOffBits + row_bytes * (uint64_t)bmp->height;
+    
+    // 像素阵列必须完整地位于文件内
+    if (pixel_end > bmp->map_size || row_bytes > INT32_MAX) {
+        fprintf(stderr, "Error: Cannot read pixel data\n");
+        bmp_unmap_file(bmp);
+        return -1;
+    }
+    
+    bmp->row_bytes = (int)row_bytes;
+    bmp->pixel_bytes = (size_t)(row_bytes * (uint64_t)bmp->height);
+    return 0;
+}
+
+/**
+ * 映射BMP文件用于解码 (提前读入整个文件)
+ */
+static int bmp_map_file(const char *filename, bmp_mapped_t *bmp) {
+    return bmp_map_file_ex(filename, bmp, BMP_MAP_PREFETCH);
+}
+
+/**
+ * 解除BMP文件映射
+ */
+static void bmp_unmap_file(bmp_mapped_t *bmp) {
+    if (bmp->map) {
+        munmap(bmp->map, bmp->map_size);
+        bmp->map = NULL;
+    }
+    bmp->pixels = NULL;
+}
+
+/**
+ * 把已映射的BMP文件完整转换为RGB565图像，写入 data (宽x高个像素)
+ */
+static int bmp_decode_to(const bmp_mapped_t *bmp, BMPImage *image, uint16_t *data) {
+    // 设置图像参数
+    image->width = bmp->width;
+    image->height = bmp->height;
+    image->bpp = bmp->bpp;
+    image->data = data;
+    
+    // RLE只能顺序解码，直接解到图像的各行中
+    if (bmp->format == BMP_PIXEL_RLE8 || bmp->format == BMP_PIXEL_RLE4) {
+        uint16_t *row = (uint16_t *)fbtft_pool_alloc((size_t)image->width * sizeof(uint16_t));
+        if (!row) {
+            fprintf(stderr, "Error: Cannot allocate memory for image data\n");
+            return -1;
+        }
+        bmp_decode_rle(bmp, row, rle_image_sink, image);
+        fbtft_pool_free(row);
+        return 0;
+    }
     
-    // 分配内存
-    size_t data_size = image->width * image->height * sizeof(uint16_t);
-    image->data = (uint16_t *)malloc(data_size);
-    if (!image->data) {
+    // 按行条带并行转换，自下而上和自上而下存储的文件都直接从映射读取
+    bmp_convert_job_t job;
+    job.bmp = bmp;
+    job.image = image;
+    fbtft_parallel_rows(image->height, (size_t)bmp->row_bytes, bmp_convert_band, &job);
+    
+    return 0;
+}
+
+/**
+ * 把已映射的BMP文件完整转换为RGB565图像 (像素内存从缓冲区池中取)
+ */
+static int bmp_decode_mapped(const bmp_mapped_t *bmp, BMPImage *image) {
+    size_t data_size = (size_t)bmp->width * bmp->height * sizeof(uint16_t);
+    uint16_t *data = (uint16_t *)fbtft_pool_alloc(data_size);
+    if (!data) {
         fprintf(stderr, "Error: Cannot allocate memory for image data\n");
-        fclose(file);
+        image->data = NULL;
         return -1;
     }
     
-    // 分配临时行缓冲区
-    uint8_t *row_buffer = (uint8_t *)malloc(row_bytes);
-    if (!row_buffer) {
-        fprintf(stderr, "Error: Cannot allocate memory for row buffer\n");
-        free(image->data);
-        fclose(file);
+    if (bmp_decode_to(bmp, image, data) != 0) {
+        fbtft_pool_free(data);
+        image->data = NULL;
         return -1;
     }
+    image->owns_data = 1;
+    return 0;
+}
+
+// 流式缩小时的行转换上下文
+typedef struct {
+    fbtft_scale_stream_t *stream;
+    uint8_t *bgr;               // 一行的BGR888临时缓冲区
+    int width;
+} bmp_stream_ctx_t;
+
+/**
+ * 把一行RGB565展开为BGR888后送入流式缩小器
+ */
+static void stream_sink(void *ctx, int file_row, const uint16_t *row) {
+    bmp_stream_ctx_t *sc = (bmp_stream_ctx_t *)ctx;
+    (void)file_row;
     
-    // 移动到像素数据位置
-    fseek(file, file_header.bfOffBits, SEEK_SET);
+    if (fbtft_scale_stream_row_needed(sc->stream)) {
+        convert_row_rgb565_to_bgr888(sc->bgr, row, sc->width);
+        fbtft_scale_stream_push_row(sc->stream, sc->bgr, 3);
+    } else {
+        fbtft_scale_stream_push_row(sc->stream, NULL, 3);
+    }
+}
+
+/**
+ * 按存储顺序把已映射的像素行送入流式缩小器，只写出目标尺寸的图像
+ * 不会被用到的行不访问；文件按 BMP_MAP_STREAM 映射，只有内核顺序预读的窗口进入页缓存
+ */
+static int bmp_stream_mapped(const bmp_mapped_t *bmp, uint16_t *buffer, int buf_width, int buf_height, 
+                             int buf_stride, scale_filter_t filter, scale_policy_t policy, 
+                             uint16_t bg_color) {
+    fbtft_scale_stream_t stream;
+    if (fbtft_scale_stream_init(&stream, bmp->width, bmp->height, bmp->is_bottom_up, 
+                                buffer, buf_width, buf_height, buf_stride, 
+                                filter, policy, bg_color) != 0) {
+        return -1;
+    }
     
-    // 读取像素数据
-    int is_bottom_up = (info_header.biHeight > 0);
+    // 24/32位的行直接从映射送入
+    if (bmp->bytes_per_pixel) {
+        for (int i = 0; i < bmp->height; i++) {
+            const uint8_t *row = NULL;
+            if (fbtft_scale_stream_row_needed(&stream)) {
+                row = bmp->pixels + (size_t)i * bmp->row_bytes;
+            }
+            fbtft_scale_stream_push_row(&stream, row, bmp->bytes_per_pixel);
+        }
+        fbtft_scale_stream_destroy(&stream);
+        return 0;
+    }
+    
+    // 其他格式先逐行转换为RGB565，再展开为BGR888
+    uint16_t *row565 = (uint16_t *)fbtft_pool_alloc((size_t)bmp->width * sizeof(uint16_t));
+    uint8_t *bgr = (uint8_t *)fbtft_pool_alloc((size_t)bmp->width * 3);
+    if (!row565 || !bgr) {
+        fprintf(stderr, "Error: Cannot allocate row buffers\n");
+        fbtft_pool_free(row565);
+        fbtft_pool_free(bgr);
+        fbtft_scale_stream_destroy(&stream);
+        return -1;
+    }
     
-    for (int y = 0; y < image->height; y++) {
-        // 读取一行数据
-        if (fread(row_buffer, row_bytes, 1, file) != 1) {
-            fprintf(stderr, "Error: Cannot read pixel data\n");
-            free(row_buffer);
-            free(image->data);
-            fclose(file);
+    bmp_stream_ctx_t sc = {&stream, bgr, bmp->width};
+    if (bmp->format == BMP_PIXEL_RLE8 || bmp->format == BMP_PIXEL_RLE4) {
+        bmp_decode_rle(bmp, row565, stream_sink, &sc);
+    } else {
+        for (int i = 0; i < bmp->height; i++) {
+            if (fbtft_scale_stream_row_needed(&stream)) {
+                bmp_decode_row(bmp, i, row565);
+            }
+            stream_sink(&sc, i, row565);
+        }
+    }
+    
+    fbtft_pool_free(row565);
+    fbtft_pool_free(bgr);
+    fbtft_scale_stream_destroy(&stream);
+    return 0;
+}
+
+/**
+ * 把已映射文件中的一个矩形区域转换为RGB565
+ * 未压缩格式直接定位到区域的行和列，只访问区域覆盖的字节；RLE只能从头顺序解码
+ * 文件应按 BMP_MAP_RANDOM 映射，这里只对区域覆盖的行提前读入
+ */
+static int bmp_region_mapped(const bmp_mapped_t *bmp, const fbtft_rect_t *rect, uint16_t *dst, int dst_stride) {
+    bmp_region_job_t job;
+    job.bmp = bmp;
+    job.rect = *rect;
+    job.dst = dst;
+    job.dst_stride = dst_stride;
+    
+    if (bmp->format == BMP_PIXEL_RLE8 || bmp->format == BMP_PIXEL_RLE4) {
+        uint16_t *row = (uint16_t *)fbtft_pool_alloc((size_t)bmp->width * sizeof(uint16_t));
+        if (!row) {
+            fprintf(stderr, "Error: Cannot allocate row buffers\n");
             return -1;
         }
-        
-        // 计算目标行索引
-        int dst_y = is_bottom_up ? (image->height - 1 - y) : y;
-        
-        // 转换像素格式到RGB565
-        for (int x = 0; x < image->width; x++) {
-            uint8_t b, g, r;
-            
-            if (bytes_per_pixel == 3) {
-                // 24位BMP: BGR
-                b = row_buffer[x * 3 + 0];
-                g = row_buffer[x * 3 + 1];
-                r = row_buffer[x * 3 + 2];
-            } else {
-                // 32位BMP: BGRA (忽略alpha通道)
-                b = row_buffer[x * 4 + 0];
-                g = row_buffer[x * 4 + 1];
-                r = row_buffer[x * 4 + 2];
-                // uint8_t a = row_buffer[x * 4 + 3]; // alpha通道暂不使用
-            }
-            
-            // 转换到RGB565
-            image->data[dst_y * image->width + x] = bgr_to_rgb565(b, g, r);
+        // RLE要从头解码到区域的最后一行，仍按顺序提前读入
+        madvise(bmp->map, bmp->map_size, MADV_SEQUENTIAL);
+        madvise(bmp->map, bmp->map_size, MADV_WILLNEED);
+        bmp_decode_rle(bmp, row, rle_region_sink, &job);
+        fbtft_pool_free(row);
+        return 0;
+    }
+    
+    // 只提前读入区域各行所在的页 (自下而上存储时区域在文件中的顺序相反)
+    int first_row = bmp->is_bottom_up ? (bmp->height - rect->y - rect->h) : rect->y;
+    bmp_prefetch_range(bmp, bmp->file_header.bfOffBits + (size_t)first_row * bmp->row_bytes, 
+                       (size_t)rect->h * bmp->row_bytes);
+    
+    fbtft_parallel_rows(rect->h, (size_t)rect->w * sizeof(uint16_t), bmp_region_band, &job);
+    return 0;
+}
+
+/**
+ * 加载BMP图像
+ * 文件通过mmap映射，直接从映射的像素阵列转换为RGB565，不经过stdio和行缓冲区
+ * 像素内存来自缓冲区池，必须用 bmp_free 释放，不能直接 free(image->data)
+ */
+int bmp_load(const char *filename, BMPImage *image) {
+    if (!filename || !image) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    bmp_mapped_t bmp;
+    if (bmp_map_file(filename, &bmp) != 0) {
+        return -1;
+    }
+    
+    int ret = bmp_decode_mapped(&bmp, image);
+    bmp_unmap_file(&bmp);
+    if (ret != 0) {
+        return -1;
+    }
+    
+    printf("BMP loaded: %s (%dx%d, %d-bit)\n", filename, image->width, image->height, image->bpp);
+    return 0;
+}
+
+/**
+ * 32位文件的alpha字节是否有效
+ * BI_BITFIELDS 需要V4/V5信息头中的alpha掩码为0xFF000000；
+ * 很多程序把不使用的alpha字节写成0，全部为0时按不透明处理
+ */
+static int bmp_has_alpha(const bmp_mapped_t *bmp) {
+    if (bmp->format != BMP_PIXEL_BGRA8888) return 0;
+    
+    if (bmp->info_header.biCompression == BMP_BI_BITFIELDS) {
+        // alpha掩码位于红、绿、蓝掩码之后，只有V4及以上的信息头才有
+        size_t offset = sizeof(BMPFileHeader) + sizeof(BMPInfoHeader) + 3 * sizeof(uint32_t);
+        uint32_t alpha_mask;
+        if (bmp->info_header.biSize < sizeof(BMPInfoHeader) + 4 * sizeof(uint32_t) ||
+            offset + sizeof(alpha_mask) > bmp->map_size) {
+            return 0;
+        }
+        memcpy(&alpha_mask, (const uint8_t *)bmp->map + offset, sizeof(alpha_mask));
+        if (alpha_mask != 0xFF000000u) return 0;
+    }
+    
+    for (int y = 0; y < bmp->height; y++) {
+        const uint8_t *row = bmp->pixels + (size_t)y * bmp->row_bytes;
+        for (int x = 0; x < bmp->width; x++) {
+            if (row[x * 4 + 3]) return 1;
         }
     }
+    return 0;
+}
+
+/**
+ * 加载BMP图像为预乘alpha图像 (用于 fbtft_alpha_blend)
+ * 带alpha的32位文件按每像素alpha预乘，其余格式按完全不透明加载
+ * @return 成功返回0，失败返回-1；image 用 fbtft_alpha_destroy 释放
+ */
+int bmp_load_alpha(const char *filename, fbtft_alpha_image_t *image) {
+    if (!filename || !image) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    bmp_mapped_t bmp;
+    if (bmp_map_file(filename, &bmp) != 0) {
+        return -1;
+    }
+    
+    if (fbtft_alpha_create(image, bmp.width, bmp.height) != 0) {
+        bmp_unmap_file(&bmp);
+        return -1;
+    }
+    
+    int has_alpha = bmp_has_alpha(&bmp);
+    int ret = 0;
+    if (has_alpha) {
+        for (int y = 0; y < bmp.height; y++) {
+            int file_row = bmp.is_bottom_up ? (bmp.height - 1 - y) : y;
+            convert_row_bgra8888_to_rgb565_premul(image->color + (size_t)y * bmp.width, 
+                                                  image->alpha + (size_t)y * bmp.width, 
+                                                  bmp.pixels + (size_t)file_row * bmp.row_bytes, bmp.width);
+        }
+    } else {
+        BMPImage decoded;
+        ret = bmp_decode_to(&bmp, &decoded, image->color);
+        memset(image->alpha, 255, (size_t)bmp.width * bmp.height);
+    }
+    bmp_unmap_file(&bmp);
+    
+    if (ret == 0) {
+        ret = fbtft_alpha_update_runs(image);
+    }
+    if (ret != 0) {
+        fbtft_alpha_destroy(image);
+        return -1;
+    }
+    
+    printf("BMP loaded: %s (%dx%d, %d-bit, %s)\n", filename, image->width, image->height, bmp.bpp, 
+           has_alpha ? "alpha" : "opaque");
+    return 0;
+}
+
+/**
+ * 加载BMP图像到调用者提供的缓冲区，不分配内存
+ * 解码后 image->data 指向 buffer，bmp_free 不会释放它
+ * @param buffer_pixels 缓冲区能容纳的像素数，至少为 宽x高 (可先用 bmp_get_info 获取)
+ * @return 成功返回0，失败或缓冲区不够返回-1
+ */
+int bmp_load_into(const char *filename, BMPImage *image, uint16_t *buffer, size_t buffer_pixels) {
+    if (!filename || !image || !buffer) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
     
-    free(row_buffer);
-    fclose(file);
+    bmp_mapped_t bmp;
+    if (bmp_map_file(filename, &bmp) != 0) {
+        return -1;
+    }
+    
+    size_t pixels = (size_t)bmp.width * bmp.height;
+    if (pixels > buffer_pixels) {
+        fprintf(stderr, "Error: Buffer too small for %s (%dx%d needs %zu pixels)\n", 
+                filename, bmp.width, bmp.height, pixels);
+        bmp_unmap_file(&bmp);
+        return -1;
+    }
+    
+    int ret = bmp_decode_to(&bmp, image, buffer);
+    bmp_unmap_file(&bmp);
+    image->owns_data = 0;
+    if (ret != 0) {
+        image->data = NULL;
+        return -1;
+    }
     
     printf("BMP loaded: %s (%dx%d, %d-bit)\n", filename, image->width, image->height, image->bpp);
     return 0;
 }
 
 /**
- * 释放BMP图像内存
+ * 只解码BMP图像中的一个矩形区域 (例如从图集中取出一块)
+ * 耗时与区域大小成正比，与文件大小无关 (RLE压缩的文件除外)
+ * @param x, y 区域左上角在图像中的坐标 (自上而下)
+ * @param buf_stride 缓冲区每行像素数，0表示等于 w
+ * @return 成功返回0，区域超出图像或失败返回-1
+ */
+int bmp_load_region(const char *filename, int x, int y, int w, int h, uint16_t *buffer, int buf_stride) {
+    if (!filename || !buffer || x < 0 || y < 0 || w <= 0 || h <= 0) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    if (buf_stride == 0) {
+        buf_stride = w;
+    }
+    if (buf_stride < w) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    bmp_mapped_t bmp;
+    if (bmp_map_file_ex(filename, &bmp, BMP_MAP_RANDOM) != 0) {
+        return -1;
+    }
+    
+    if (x > bmp.width - w || y > bmp.height - h) {
+        fprintf(stderr, "Error: Region %dx%d at (%d,%d) is outside image %dx%d\n", 
+                w, h, x, y, bmp.width, bmp.height);
+        bmp_unmap_file(&bmp);
+        return -1;
+    }
+    
+    fbtft_rect_t rect = {x, y, w, h};
+    int ret = bmp_region_mapped(&bmp, &rect, buffer, buf_stride);
+    bmp_unmap_file(&bmp);
+    return ret;
+}
+
+/**
+ * 只读取BMP文件头，获取图像尺寸和位深
+ * 不提前读入像素数据，只有文件头和调色板所在的页会被读取
+ * @return 文件有效且格式受支持时返回0，否则返回-1
+ */
+int bmp_get_info(const char *filename, int *width, int *height, int *bpp) {
+    if (!filename) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    bmp_mapped_t bmp;
+    if (bmp_map_file_ex(filename, &bmp, BMP_MAP_RANDOM) != 0) {
+        return -1;
+    }
+    
+    if (width) *width = bmp.width;
+    if (height) *height = bmp.height;
+    if (bpp) *bpp = bmp.bpp;
+    bmp_unmap_file(&bmp);
+    return 0;
+}
+
+/**
+ * 边解码边缩放BMP图像到缓冲区
+ * 不分配完整的源图像，额外内存只有坐标表和一两行的中间结果
+ * @param buf_stride 缓冲区每行像素数，0表示等于 buf_width
+ * @return 成功返回0，失败返回-1
+ */
+int bmp_load_scaled(const char *filename, uint16_t *buffer, int buf_width, int buf_height, int buf_stride, 
+                    scale_filter_t filter, scale_policy_t policy, uint16_t bg_color) {
+    if (!filename || !buffer) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    bmp_mapped_t bmp;
+    if (bmp_map_file_ex(filename, &bmp, BMP_MAP_STREAM) != 0) {
+        return -1;
+    }
+    
+    int ret = bmp_stream_mapped(&bmp, buffer, buf_width, buf_height, buf_stride, 
+                                filter, policy, bg_color);
+    bmp_unmap_file(&bmp);
+    
+    if (ret == 0) {
+        printf("BMP streamed: %s (%dx%d -> %dx%d)\n", filename, bmp.width, bmp.height, 
+               buf_width, buf_height);
+    }
+    return ret;
+}
+
+/**
+ * 把已映射的BMP文件按适配模式写入缓冲区 (行距等于 buf_width)
+ * 源图像在两个方向上都大于目标区域时走流式区域平均缩小，不分配完整的源图像；
+ * 否则完整解码后按 bmp_convert_fit 适配
+ */
+static int bmp_fit_mapped(bmp_mapped_t *bmp, const char *filename, uint16_t *buffer, 
+                          int buf_width, int buf_height, fit_mode_t fit) {
+    // 与 bmp_convert_to_rgb565_smart_fit 相同的自动旋转判断
+    rotation_t rotation = ROTATE_0;
+    if (fit == FIT_AUTO) {
+        if (bmp->width > bmp->height && buf_width < buf_height) {
+            rotation = ROTATE_90;
+        } else if (bmp->width < bmp->height && buf_width > buf_height) {
+            rotation = ROTATE_270;
+        }
+    }
+    
+    // 旋转前的目标尺寸
+    int fit_width = (rotation == ROTATE_0) ? buf_width : buf_height;
+    int fit_height = (rotation == ROTATE_0) ? buf_height : buf_width;
+    scale_policy_t policy = (fit == FIT_SCALE) ? SCALE_LETTERBOX : SCALE_STRETCH;
+    
+    fbtft_rect_t src_rect, dst_rect;
+    fbtft_scale_fit(bmp->width, bmp->height, fit_width, fit_height, policy, &src_rect, &dst_rect);
+    int oversized = src_rect.w >= dst_rect.w && src_rect.h >= dst_rect.h && 
+                    (src_rect.w > dst_rect.w || src_rect.h > dst_rect.h);
+    
+    int ret;
+    if (oversized) {
+        uint16_t *rotated = NULL;
+        uint16_t *target = buffer;
+        if (rotation != ROTATE_0) {
+            rotated = (uint16_t *)fbtft_pool_alloc((size_t)buf_width * buf_height * sizeof(uint16_t));
+            if (!rotated) {
+                fprintf(stderr, "Error: Cannot allocate memory for image data\n");
+                return -1;
+            }
+            target = rotated;
+        }
+        
+        ret = bmp_stream_mapped(bmp, target, fit_width, fit_height, fit_width, 
+                                SCALE_BOX, policy, 0x0000);
+        if (ret == 0 && rotation == ROTATE_90) {
+            fbtft_lcd_rotate_90(rotated, buffer, fit_width, fit_height);
+        } else if (ret == 0 && rotation == ROTATE_270) {
+            fbtft_lcd_rotate_270(rotated, buffer, fit_width, fit_height);
+        }
+        fbtft_pool_free(rotated);
+        
+        if (ret == 0) {
+            printf("BMP streamed: %s (%dx%d -> %dx%d)\n", filename, bmp->width, bmp->height, 
+                   buf_width, buf_height);
+        }
+    } else {
+        // 要完整解码，这时才提前读入整个文件
+        bmp_prefetch_range(bmp, 0, bmp->map_size);
+        BMPImage image;
+        ret = bmp_decode_mapped(bmp, &image);
+        if (ret == 0) {
+            printf("BMP loaded: %s (%dx%d, %d-bit)\n", filename, image.width, image.height, image.bpp);
+            ret = bmp_convert_fit(&image, buffer, buf_width, buf_height, fit);
+            bmp_free(&image);
+        }
+    }
+    
+    return ret;
+}
+
+/**
+ * 按适配模式加载BMP图像到缓冲区 (行距等于 buf_width)
+ */
+int bmp_load_fit(const char *filename, uint16_t *buffer, int buf_width, int buf_height, fit_mode_t fit) {
+    if (!filename || !buffer || buf_width <= 0 || buf_height <= 0) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    bmp_mapped_t bmp;
+    if (bmp_map_file_ex(filename, &bmp, BMP_MAP_STREAM) != 0) {
+        return -1;
+    }
+    
+    int ret = bmp_fit_mapped(&bmp, filename, buffer, buf_width, buf_height, fit);
+    bmp_unmap_file(&bmp);
+    return ret;
+}
+
+/**
+ * 按适配模式加载BMP图像并旋转，得到可以直接提交的帧 (行距等于 buf_width)
+ * 90/270度时先按交换后的宽高适配，再一次性旋转到缓冲区
+ * @param buf_width, buf_height 旋转后的尺寸 (屏幕尺寸)
+ * @param info 不为NULL时返回源图像信息 (与 bmp_get_info 相同，取自解码用的同一次映射)
+ */
+int bmp_load_fit_rotated(const char *filename, uint16_t *buffer, int buf_width, int buf_height, 
+                         fit_mode_t fit, rotation_t rotation, BMPInfo *info) {
+    if (!filename || !buffer || buf_width <= 0 || buf_height <= 0) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    bmp_mapped_t bmp;
+    if (bmp_map_file_ex(filename, &bmp, BMP_MAP_STREAM) != 0) {
+        return -1;
+    }
+    if (info) {
+        info->width = bmp.width;
+        info->height = bmp.height;
+        info->bpp = bmp.bpp;
+    }
+    
+    int ret;
+    int ops = fbtft_blit_transform_ops(rotation, MIRROR_NONE);
+    if (ops == 0) {
+        ret = bmp_fit_mapped(&bmp, filename, buffer, buf_width, buf_height, fit);
+    } else {
+        int fit_width = (ops & FBTFT_BLIT_TRANSPOSE) ? buf_height : buf_width;
+        int fit_height = (ops & FBTFT_BLIT_TRANSPOSE) ? buf_width : buf_height;
+        
+        uint16_t *fitted = (uint16_t *)fbtft_pool_alloc((size_t)buf_width * buf_height * sizeof(uint16_t));
+        if (!fitted) {
+            fprintf(stderr, "Error: Cannot allocate memory for image data\n");
+            bmp_unmap_file(&bmp);
+            return -1;
+        }
+        
+        ret = bmp_fit_mapped(&bmp, filename, fitted, fit_width, fit_height, fit);
+        if (ret == 0) {
+            fbtft_blit_transform(buffer, (size_t)buf_width * sizeof(uint16_t), 
+                                 fitted, (size_t)fit_width * sizeof(uint16_t), fit_width, fit_height, ops);
+        }
+        fbtft_pool_free(fitted);
+    }
+    
+    bmp_unmap_file(&bmp);
+    return ret;
+}
+
+/**
+ * 释放BMP图像内存 (像素内存归还到缓冲区池，调用者提供的缓冲区不释放)
  */
 void bmp_free(BMPImage *image) {
     if (!image) return;
     
-    if (image->data) {
-        free(image->data);
-        image->data = NULL;
+    if (image->data && image->owns_data) {
+        fbtft_pool_free(image->data);
     }
+    image->data = NULL;
+    image->owns_data = 0;
     
     image->width = 0;
     image->height = 0;
@@ -152,65 +1072,66 @@ int bmp_convert_to_rgb565(BMPImage *image, uint16_t *buffer, int buf_width, int
         return -1;
     }
     
-    // 计算缩放和居中参数
-    float scale_x = (float)buf_width / image->width;
-    float scale_y = (float)buf_height / image->height;
-    float scale = (scale_x < scale_y) ? scale_x : scale_y;
-    
-    int new_width = (int)(image->width * scale);
-    int new_height = (int)(image->height * scale);
-    int offset_x = (buf_width - new_width) / 2;
-    int offset_y = (buf_height - new_height) / 2;
-    
-    // 首先清除缓冲区
-    for (int i = 0; i < buf_width * buf_height; i++) {
-        buffer[i] = 0x0000; // 黑色背景
-    }
-    
-    // 简单最近邻插值缩放
-    for (int y = 0; y < new_height; y++) {
-        for (int x = 0; x < new_width; x++) {
-            int src_x = (int)(x / scale);
-            int src_y = (int)(y / scale);
-            
-            // 边界检查
-            if (src_x >= image->width) src_x = image->width - 1;
-            if (src_y >= image->height) src_y = image->height - 1;
-            
-            int dst_x = x + offset_x;
-            int dst_y = y + offset_y;
-            
-            if (dst_x >= 0 && dst_x < buf_width && dst_y >= 0 && dst_y < buf_height) {
-                buffer[dst_y * buf_width + dst_x] = image->data[src_y * image->width + src_x];
-            }
-        }
-    }
-    
-    return 0;
+    // 保持宽高比缩放并居中，空白部分为黑色背景
+    return fbtft_scale_rgb565(image->data, image->width, image->height, image->width, 
+                              buffer, buf_width, buf_height, buf_width, 
+                              SCALE_NEAREST, SCALE_LETTERBOX, 0x0000);
 }
 
 /**
  * 直接将BMP文件绘制到缓冲区
+ * 只解码落在缓冲区以内的部分
  */
 int bmp_draw_to_buffer(const char *filename, uint16_t *buffer, int buf_width, int buf_height, 
                       int dst_x, int dst_y) {
-    BMPImage image;
+    if (!filename || !buffer || buf_width <= 0 || buf_height <= 0) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
     
-    if (bmp_load(filename, &image) != 0) {
+    bmp_mapped_t bmp;
+    if (bmp_map_file_ex(filename, &bmp, BMP_MAP_RANDOM) != 0) {
         return -1;
     }
     
-    // 简单复制（不缩放）
-    for (int y = 0; y < image.height && (dst_y + y) < buf_height; y++) {
-        for (int x = 0; x < image.width && (dst_x + x) < buf_width; x++) {
-            if ((dst_x + x) >= 0 && (dst_y + y) >= 0) {
-                buffer[(dst_y + y) * buf_width + (dst_x + x)] = 
-                    image.data[y * image.width + x];
-            }
-        }
+    // 简单复制（不缩放），把图像裁剪到缓冲区以内
+    fbtft_rect_t rect;
+    rect.x = dst_x < 0 ? -dst_x : 0;
+    rect.y = dst_y < 0 ? -dst_y : 0;
+    rect.w = (bmp.width < buf_width - dst_x ? bmp.width : buf_width - dst_x) - rect.x;
+    rect.h = (bmp.height < buf_height - dst_y ? bmp.height : buf_height - dst_y) - rect.y;
+    
+    int ret = 0;
+    if (rect.w > 0 && rect.h > 0) {
+        uint16_t *dst = buffer + (size_t)(dst_y + rect.y) * buf_width + (dst_x + rect.x);
+        ret = bmp_region_mapped(&bmp, &rect, dst, buf_width);
+    }
+    
+    bmp_unmap_file(&bmp);
+    return ret;
+}
+
+/**
+ * 把BMP文件按alpha叠加到缓冲区 (透明部分保留缓冲区原有内容)
+ * 每次调用都会重新解码，反复叠加同一图标时应先用 bmp_load_alpha 加载一次
+ */
+int bmp_blend_to_buffer(const char *filename, uint16_t *buffer, int buf_width, int buf_height, 
+                        int dst_x, int dst_y) {
+    if (!filename || !buffer || buf_width <= 0 || buf_height <= 0) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
     }
     
-    bmp_free(&image);
+    fbtft_alpha_image_t image;
+    if (bmp_load_alpha(filename, &image) != 0) {
+        return -1;
+    }
+    
+    fbtft_surface_t surface;
+    fbtft_surface_wrap(&surface, buffer, buf_width, buf_height, buf_width);
+    fbtft_alpha_blend(&surface, dst_x, dst_y, &image);
+    
+    fbtft_alpha_destroy(&image);
     return 0;
 }
 
@@ -232,6 +1153,7 @@ void rgb565_to_bgr(uint16_t color, uint8_t *b, uint8_t *g, uint8_t *r) {
 
 /**
  * 智能适配BMP图像到缓冲区（支持自动旋转以最佳填充屏幕）
+ * 旋转在缩放取样时完成，不需要旋转后的中间图像
  */
 int bmp_convert_to_rgb565_smart_fit(BMPImage *image, uint16_t *buffer, int buf_width, int buf_height, int auto_rotate) {
     if (!image || !image->data || !buffer) {
@@ -240,96 +1162,44 @@ int bmp_convert_to_rgb565_smart_fit(BMPImage *image, uint16_t *buffer, int buf_w
     
     int src_width = image->width;
     int src_height = image->height;
-    uint16_t *src_data = image->data;
-    uint16_t *rotated_data = NULL;
+    rotation_t rotation = ROTATE_0;
     
     // 检查是否需要自动旋转
     if (auto_rotate) {
         // 如果图像是横屏(320x240)而屏幕是竖屏(240x320)，自动旋转90度
         if (src_width > src_height && buf_width < buf_height) {
             printf("Auto-rotating image 90° (landscape to portrait)\n");
-            
-            // 分配旋转后的缓冲区
-            rotated_data = (uint16_t *)malloc(src_width * src_height * sizeof(uint16_t));
-            if (!rotated_data) {
-                return -1;
-            }
-            
-            // 90度旋转: 将320x240转为240x320
-            for (int y = 0; y < src_height; y++) {
-                for (int x = 0; x < src_width; x++) {
-                    // (x, y) -> (y, src_width - 1 - x)
-                    int new_x = y;
-                    int new_y = src_width - 1 - x;
-                    rotated_data[new_y * src_height + new_x] = src_data[y * src_width + x];
-                }
-            }
-            
-            // 更新尺寸和数据指针
-            src_data = rotated_data;
-            int temp = src_width;
-            src_width = src_height;
-            src_height = temp;
+            rotation = ROTATE_90;
         }
         // 如果图像是竖屏而屏幕是横屏，也可以类似处理
         else if (src_width < src_height && buf_width > buf_height) {
             printf("Auto-rotating image 270° (portrait to landscape)\n");
-            
-            rotated_data = (uint16_t *)malloc(src_width * src_height * sizeof(uint16_t));
-            if (!rotated_data) {
-                return -1;
-            }
-            
-            // 270度旋转 (或-90度)
-            for (int y = 0; y < src_height; y++) {
-                for (int x = 0; x < src_width; x++) {
-                    // (x, y) -> (src_height - 1 - y, x)
-                    int new_x = src_height - 1 - y;
-                    int new_y = x;
-                    rotated_data[new_y * src_height + new_x] = src_data[y * src_width + x];
-                }
-            }
-            
-            src_data = rotated_data;
-            int temp = src_width;
-            src_width = src_height;
-            src_height = temp;
-        }
-    }
-    
-    // 现在进行缩放适配
-    // 选择拉伸填充还是保持宽高比
-    // 这里我们使用拉伸填充以完全利用屏幕空间
-    if (src_width == buf_width && src_height == buf_height) {
-        // 完全匹配，直接复制
-        memcpy(buffer, src_data, buf_width * buf_height * sizeof(uint16_t));
-    } else {
-        // 使用双线性插值进行缩放
-        for (int y = 0; y < buf_height; y++) {
-            for (int x = 0; x < buf_width; x++) {
-                // 计算源图像中的对应位置
-                float src_x = (float)x * src_width / buf_width;
-                float src_y = (float)y * src_height / buf_height;
-                
-                // 简单最近邻插值
-                int ix = (int)(src_x + 0.5f);
-                int iy = (int)(src_y + 0.5f);
-                
-                // 边界检查
-                if (ix >= src_width) ix = src_width - 1;
-                if (iy >= src_height) iy = src_height - 1;
-                if (ix < 0) ix = 0;
-                if (iy < 0) iy = 0;
-                
-                buffer[y * buf_width + x] = src_data[iy * src_width + ix];
-            }
+            rotation = ROTATE_270;
         }
     }
     
-    // 清理旋转缓冲区
-    if (rotated_data) {
-        free(rotated_data);
+    // 缩放适配的同时按旋转后的顺序取样
+    // 使用拉伸填充以完全利用屏幕空间，尺寸完全匹配时缩放器直接按旋转复制
+    return fbtft_scale_rgb565_transformed(image->data, src_width, src_height, src_width, 
+                                          buffer, buf_width, buf_height, buf_width, 
+                                          SCALE_BILINEAR, SCALE_STRETCH, 0x0000, 
+                                          rotation, MIRROR_NONE);
+}
+
+/**
+ * 按适配模式把BMP图像转换到缓冲区
+ */
+int bmp_convert_fit(BMPImage *image, uint16_t *buffer, int buf_width, int buf_height, fit_mode_t fit) {
+    switch (fit) {
+        case FIT_AUTO:
+            // 自动旋转以最佳适配
+            return bmp_convert_to_rgb565_smart_fit(image, buffer, buf_width, buf_height, 1);
+        case FIT_STRETCH:
+            // 拉伸填充整个缓冲区
+            return bmp_convert_to_rgb565_smart_fit(image, buffer, buf_width, buf_height, 0);
+        case FIT_SCALE:
+        default:
+            // 保持宽高比缩放
+            return bmp_convert_to_rgb565(image, buffer, buf_width, buf_height);
     }
-    
-    return 0;
 }
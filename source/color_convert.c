@@ -0,0 +1,371 @@
+#include "color_convert.h"
+#include <pthread.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define COLOR_CONVERT_NEON 1
+#if !defined(__aarch64__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#elif defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#define COLOR_CONVERT_X86 1
+#endif
+
+typedef void (*convert_row_fn_t)(uint16_t *dst, const uint8_t *src, int count);
+
+// 运行时选定的实现
+static struct {
+    convert_row_fn_t bgr888;
+    convert_row_fn_t bgra8888;
+    convert_row_fn_t rgb555;
+    const char *name;
+} backend;
+
+static pthread_once_t backend_once = PTHREAD_ONCE_INIT;
+
+static inline uint16_t pack_rgb565(uint8_t b, uint8_t g, uint8_t r) {
+    return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+/**
+ * 标量实现：每次处理4个像素
+ */
+static void bgr888_scalar(uint16_t *dst, const uint8_t *src, int count) {
+    int i = 0;
+    
+    for (; i + 4 <= count; i += 4, src += 12) {
+        dst[i + 0] = pack_rgb565(src[0], src[1], src[2]);
+        dst[i + 1] = pack_rgb565(src[3], src[4], src[5]);
+        dst[i + 2] = pack_rgb565(src[6], src[7], src[8]);
+        dst[i + 3] = pack_rgb565(src[9], src[10], src[11]);
+    }
+    for (; i < count; i++, src += 3) {
+        dst[i] = pack_rgb565(src[0], src[1], src[2]);
+    }
+}
+
+static void bgra8888_scalar(uint16_t *dst, const uint8_t *src, int count) {
+    int i = 0;
+    
+    for (; i + 4 <= count; i += 4, src += 16) {
+        dst[i + 0] = pack_rgb565(src[0], src[1], src[2]);
+        dst[i + 1] = pack_rgb565(src[4], src[5], src[6]);
+        dst[i + 2] = pack_rgb565(src[8], src[9], src[10]);
+        dst[i + 3] = pack_rgb565(src[12], src[13], src[14]);
+    }
+    for (; i < count; i++, src += 4) {
+        dst[i] = pack_rgb565(src[0], src[1], src[2]);
+    }
+}
+
+static inline uint16_t rgb555_to_rgb565(uint16_t v) {
+    return (uint16_t)(((v & 0x7C00) << 1) | ((v & 0x03E0) << 1) | ((v >> 4) & 0x0020) | (v & 0x001F));
+}
+
+static void rgb555_scalar(uint16_t *dst, const uint8_t *src, int count) {
+    int i = 0;
+    
+    // 源数据可能不是2字节对齐，按字节读取
+    for (; i + 4 <= count; i += 4, src += 8) {
+        dst[i + 0] = rgb555_to_rgb565((uint16_t)(src[0] | (src[1] << 8)));
+        dst[i + 1] = rgb555_to_rgb565((uint16_t)(src[2] | (src[3] << 8)));
+        dst[i + 2] = rgb555_to_rgb565((uint16_t)(src[4] | (src[5] << 8)));
+        dst[i + 3] = rgb555_to_rgb565((uint16_t)(src[6] | (src[7] << 8)));
+    }
+    for (; i < count; i++, src += 2) {
+        dst[i] = rgb555_to_rgb565((uint16_t)(src[0] | (src[1] << 8)));
+    }
+}
+
+#if defined(COLOR_CONVERT_NEON)
+/**
+ * NEON：vld3/vld4按通道解交织，再用移位插入(vsri)拼出RGB565
+ */
+static inline uint16x8_t neon_pack_rgb565(uint8x8_t b, uint8x8_t g, uint8x8_t r) {
+    uint16x8_t out = vshll_n_u8(r, 8);
+    out = vsriq_n_u16(out, vshll_n_u8(g, 8), 5);
+    out = vsriq_n_u16(out, vshll_n_u8(b, 8), 11);
+    return out;
+}
+
+static void bgr888_neon(uint16_t *dst, const uint8_t *src, int count) {
+    int i = 0;
+    
+    for (; i + 16 <= count; i += 16, src += 48) {
+        uint8x16x3_t px = vld3q_u8(src);
+        vst1q_u16(dst + i, neon_pack_rgb565(vget_low_u8(px.val[0]), vget_low_u8(px.val[1]),
+                                            vget_low_u8(px.val[2])));
+        vst1q_u16(dst + i + 8, neon_pack_rgb565(vget_high_u8(px.val[0]), vget_high_u8(px.val[1]),
+                                                vget_high_u8(px.val[2])));
+    }
+    bgr888_scalar(dst + i, src, count - i);
+}
+
+static void bgra8888_neon(uint16_t *dst, const uint8_t *src, int count) {
+    int i = 0;
+    
+    for (; i + 16 <= count; i += 16, src += 64) {
+        uint8x16x4_t px = vld4q_u8(src);
+        vst1q_u16(dst + i, neon_pack_rgb565(vget_low_u8(px.val[0]), vget_low_u8(px.val[1]),
+                                            vget_low_u8(px.val[2])));
+        vst1q_u16(dst + i + 8, neon_pack_rgb565(vget_high_u8(px.val[0]), vget_high_u8(px.val[1]),
+                                                vget_high_u8(px.val[2])));
+    }
+    bgra8888_scalar(dst + i, src, count - i);
+}
+
+static void rgb555_neon(uint16_t *dst, const uint8_t *src, int count) {
+    int i = 0;
+    
+    for (; i + 8 <= count; i += 8, src += 16) {
+        uint16x8_t v = vreinterpretq_u16_u8(vld1q_u8(src));
+        uint16x8_t rg = vshlq_n_u16(vandq_u16(v, vdupq_n_u16(0x7FE0)), 1);
+        uint16x8_t g0 = vandq_u16(vshrq_n_u16(v, 4), vdupq_n_u16(0x0020));
+        uint16x8_t b = vandq_u16(v, vdupq_n_u16(0x001F));
+        vst1q_u16(dst + i, vorrq_u16(vorrq_u16(rg, g0), b));
+    }
+    rgb555_scalar(dst + i, src, count - i);
+}
+#endif
+
+#if defined(COLOR_CONVERT_X86)
+/**
+ * 4个32位 BGRx 像素 -> 4个RGB565 (仍在32位通道中)
+ */
+__attribute__((target("sse2")))
+static inline __m128i sse2_bgrx_to_rgb565(__m128i v) {
+    __m128i r = _mm_and_si128(_mm_srli_epi32(v, 8), _mm_set1_epi32(0xF800));
+    __m128i g = _mm_and_si128(_mm_srli_epi32(v, 5), _mm_set1_epi32(0x07E0));
+    __m128i b = _mm_and_si128(_mm_srli_epi32(v, 3), _mm_set1_epi32(0x001F));
+    return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+
+/**
+ * 把两组32位通道中的RGB565压缩为8个16位像素
+ * packs是有符号饱和，先把低16位符号扩展，保证数值不变
+ */
+__attribute__((target("sse2")))
+static inline __m128i sse2_pack_u16(__m128i lo, __m128i hi) {
+    lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+    hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+    return _mm_packs_epi32(lo, hi);
+}
+
+__attribute__((target("sse2")))
+static void bgra8888_sse2(uint16_t *dst, const uint8_t *src, int count) {
+    int i = 0;
+    
+    for (; i + 8 <= count; i += 8, src += 32) {
+        __m128i lo = sse2_bgrx_to_rgb565(_mm_loadu_si128((const __m128i *)src));
+        __m128i hi = sse2_bgrx_to_rgb565(_mm_loadu_si128((const __m128i *)(src + 16)));
+        _mm_storeu_si128((__m128i *)(dst + i), sse2_pack_u16(lo, hi));
+    }
+    bgra8888_scalar(dst + i, src, count - i);
+}
+
+__attribute__((target("sse2")))
+static void rgb555_sse2(uint16_t *dst, const uint8_t *src, int count) {
+    int i = 0;
+    
+    for (; i + 8 <= count; i += 8, src += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)src);
+        __m128i rg = _mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x7FE0)), 1);
+        __m128i g0 = _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi16(0x0020));
+        __m128i b = _mm_and_si128(v, _mm_set1_epi16(0x001F));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_or_si128(rg, g0), b));
+    }
+    rgb555_scalar(dst + i, src, count - i);
+}
+
+/**
+ * SSSE3：pshufb把12字节的4个BGR像素展开为4个32位通道
+ */
+__attribute__((target("ssse3")))
+static void bgr888_ssse3(uint16_t *dst, const uint8_t *src, int count) {
+    const __m128i expand = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    int i = 0;
+    
+    // 第二次加载从第12字节开始读16字节，最后一组需要至少28字节可读
+    for (; i + 10 <= count; i += 8, src += 24) {
+        __m128i lo = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)src), expand);
+        __m128i hi = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(src + 12)), expand);
+        _mm_storeu_si128((__m128i *)(dst + i),
+                         sse2_pack_u16(sse2_bgrx_to_rgb565(lo), sse2_bgrx_to_rgb565(hi)));
+    }
+    bgr888_scalar(dst + i, src, count - i);
+}
+#endif
+
+/**
+ * 按CPU特性选择实现
+ */
+static void select_backend(void) {
+    backend.bgr888 = bgr888_scalar;
+    backend.bgra8888 = bgra8888_scalar;
+    backend.rgb555 = rgb555_scalar;
+    backend.name = "scalar";
+    
+#if defined(COLOR_CONVERT_NEON)
+#if defined(__aarch64__)
+    int has_neon = 1;
+#else
+    int has_neon = (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#endif
+    if (has_neon) {
+        backend.bgr888 = bgr888_neon;
+        backend.bgra8888 = bgra8888_neon;
+        backend.rgb555 = rgb555_neon;
+        backend.name = "neon";
+    }
+#elif defined(COLOR_CONVERT_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        backend.bgra8888 = bgra8888_sse2;
+        backend.rgb555 = rgb555_sse2;
+        backend.name = "sse2";
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        backend.bgr888 = bgr888_ssse3;
+        backend.name = "ssse3";
+    }
+#endif
+}
+
+/**
+ * 24位 BGR -> RGB565
+ */
+void convert_row_bgr888_to_rgb565(uint16_t *dst, const uint8_t *src, int count) {
+    if (!dst || !src || count <= 0) return;
+    
+    pthread_once(&backend_once, select_backend);
+    backend.bgr888(dst, src, count);
+}
+
+/**
+ * 32位 BGRA -> RGB565 (忽略alpha)
+ */
+void convert_row_bgra8888_to_rgb565(uint16_t *dst, const uint8_t *src, int count) {
+    if (!dst || !src || count <= 0) return;
+    
+    pthread_once(&backend_once, select_backend);
+    backend.bgra8888(dst, src, count);
+}
+
+/**
+ * 16位 RGB555 -> RGB565
+ */
+void convert_row_rgb555_to_rgb565(uint16_t *dst, const uint8_t *src, int count) {
+    if (!dst || !src || count <= 0) return;
+    
+    pthread_once(&backend_once, select_backend);
+    backend.rgb555(dst, src, count);
+}
+
+/**
+ * 8位调色板索引 -> RGB565 (查表，每次处理4个像素)
+ */
+void convert_row_index8_to_rgb565(uint16_t *dst, const uint8_t *src, int count, const uint16_t *lut) {
+    if (!dst || !src || !lut || count <= 0) return;
+    
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        dst[i + 0] = lut[src[i + 0]];
+        dst[i + 1] = lut[src[i + 1]];
+        dst[i + 2] = lut[src[i + 2]];
+        dst[i + 3] = lut[src[i + 3]];
+    }
+    for (; i < count; i++) {
+        dst[i] = lut[src[i]];
+    }
+}
+
+/**
+ * 4位调色板索引 -> RGB565 (每字节两个像素，高4位在前)
+ */
+void convert_row_index4_to_rgb565(uint16_t *dst, const uint8_t *src, int count, const uint16_t *lut) {
+    if (!dst || !src || !lut || count <= 0) return;
+    
+    int i = 0;
+    for (; i + 2 <= count; i += 2, src++) {
+        dst[i + 0] = lut[*src >> 4];
+        dst[i + 1] = lut[*src & 0x0F];
+    }
+    if (i < count) {
+        dst[i] = lut[*src >> 4];
+    }
+}
+
+/**
+ * 1位调色板索引 -> RGB565 (每字节8个像素，最高位在前)
+ */
+void convert_row_index1_to_rgb565(uint16_t *dst, const uint8_t *src, int count, const uint16_t *lut) {
+    if (!dst || !src || !lut || count <= 0) return;
+    
+    uint16_t c0 = lut[0], c1 = lut[1];
+    int i = 0;
+    for (; i + 8 <= count; i += 8, src++) {
+        uint8_t bits = *src;
+        dst[i + 0] = (bits & 0x80) ? c1 : c0;
+        dst[i + 1] = (bits & 0x40) ? c1 : c0;
+        dst[i + 2] = (bits & 0x20) ? c1 : c0;
+        dst[i + 3] = (bits & 0x10) ? c1 : c0;
+        dst[i + 4] = (bits & 0x08) ? c1 : c0;
+        dst[i + 5] = (bits & 0x04) ? c1 : c0;
+        dst[i + 6] = (bits & 0x02) ? c1 : c0;
+        dst[i + 7] = (bits & 0x01) ? c1 : c0;
+    }
+    for (int bit = 0; i < count; i++, bit++) {
+        dst[i] = (*src & (0x80 >> bit)) ? c1 : c0;
+    }
+}
+
+/**
+ * 32位 BGRA -> 预乘alpha的RGB565 + 8位alpha
+ * 各通道先乘以 alpha/255 (四舍五入)，再截断为5/6位
+ */
+void convert_row_bgra8888_to_rgb565_premul(uint16_t *dst, uint8_t *alpha, const uint8_t *src, int count) {
+    if (!dst || !alpha || !src || count <= 0) return;
+    
+    for (int i = 0; i < count; i++, src += 4) {
+        uint32_t a = src[3];
+        if (a == 255) {
+            dst[i] = pack_rgb565(src[0], src[1], src[2]);
+        } else if (a == 0) {
+            dst[i] = 0;
+        } else {
+            uint32_t b = src[0] * a + 128, g = src[1] * a + 128, r = src[2] * a + 128;
+            dst[i] = pack_rgb565((uint8_t)((b + (b >> 8)) >> 8), 
+                                 (uint8_t)((g + (g >> 8)) >> 8), 
+                                 (uint8_t)((r + (r >> 8)) >> 8));
+        }
+        alpha[i] = (uint8_t)a;
+    }
+}
+
+/**
+ * RGB565 -> 24位 BGR
+ */
+void convert_row_rgb565_to_bgr888(uint8_t *dst, const uint16_t *src, int count) {
+    if (!dst || !src || count <= 0) return;
+    
+    for (int i = 0; i < count; i++, dst += 3) {
+        uint16_t c = src[i];
+        uint8_t r = (uint8_t)((c >> 11) & 0x1F);
+        uint8_t g = (uint8_t)((c >> 5) & 0x3F);
+        uint8_t b = (uint8_t)(c & 0x1F);
+        dst[0] = (uint8_t)((b << 3) | (b >> 2));
+        dst[1] = (uint8_t)((g << 2) | (g >> 4));
+        dst[2] = (uint8_t)((r << 3) | (r >> 2));
+    }
+}
+
+/**
+ * 当前使用的实现名称
+ */
+const char *convert_row_backend(void) {
+    pthread_once(&backend_once, select_backend);
+    return backend.name;
+}
@@ -0,0 +1,272 @@
+#include "fbtft_alpha.h"
+#include "fbtft_blit.h"
+#include "fbtft_threadpool.h"
+#include "fbtft_pool.h"
+
+// 游程计算时的像素分类
+#define ALPHA_CLEAR     0
+#define ALPHA_OPAQUE    1
+#define ALPHA_BLEND     2
+
+// 叠加任务 (按区域中的行分条带)
+typedef struct {
+    const fbtft_alpha_image_t *src;
+    fbtft_rect_t rect;                  // 源图像中参与叠加的区域
+    uint16_t *dst;                      // 区域左上角对应的目标像素
+    size_t dst_stride;                  // 目标每行字节数
+    uint8_t *dst_alpha;                 // blend_over：区域左上角对应的目标alpha，否则为NULL
+    int dst_alpha_stride;               // 目标alpha每行字节数
+} alpha_job_t;
+
+static inline int alpha_class(uint8_t a) {
+    return a == 0 ? ALPHA_CLEAR : (a == 255 ? ALPHA_OPAQUE : ALPHA_BLEND);
+}
+
+/**
+ * 计算一行的游程，返回不透明/半透明游程的数量
+ * @param out 至少 width 项，先存放原始分段，合并后存放结果
+ */
+static int alpha_row_runs(const uint8_t *alpha, int width, fbtft_alpha_run_t *out) {
+    // 按alpha分类切分为连续段，opaque 字段暂存分类
+    int n = 0;
+    for (int x = 0; x < width; ) {
+        int kind = alpha_class(alpha[x]);
+        int start = x;
+        while (x < width && alpha_class(alpha[x]) == kind) x++;
+        out[n].x = (uint16_t)start;
+        out[n].length = (uint16_t)(x - start);
+        out[n].opaque = (uint8_t)kind;
+        n++;
+    }
+    
+    // 夹在半透明段旁边的短段按半透明处理 (混合公式对alpha为0或255的像素结果不变)
+    for (int i = 0; i < n; i++) {
+        if (out[i].opaque != ALPHA_BLEND && out[i].length < FBTFT_ALPHA_MIN_RUN &&
+            ((i > 0 && out[i - 1].opaque == ALPHA_BLEND) ||
+             (i + 1 < n && out[i + 1].opaque == ALPHA_BLEND))) {
+            out[i].opaque = ALPHA_BLEND;
+        }
+    }
+    
+    // 合并相邻的同类段，丢弃透明段
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        if (out[i].opaque == ALPHA_CLEAR) continue;
+        
+        if (count > 0 && out[count - 1].opaque == out[i].opaque &&
+            out[count - 1].x + out[count - 1].length == out[i].x) {
+            out[count - 1].length = (uint16_t)(out[count - 1].length + out[i].length);
+        } else {
+            out[count++] = out[i];
+        }
+    }
+    
+    for (int i = 0; i < count; i++) {
+        out[i].opaque = (out[i].opaque == ALPHA_OPAQUE);
+    }
+    return count;
+}
+
+/**
+ * 创建全透明的图像 (像素内存从缓冲区池中取)
+ */
+int fbtft_alpha_create(fbtft_alpha_image_t *image, int width, int height) {
+    if (!image || width <= 0 || height <= 0) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    memset(image, 0, sizeof(*image));
+    
+    if (width > FBTFT_ALPHA_MAX_WIDTH) {
+        fprintf(stderr, "Error: Alpha image width %d exceeds %d\n", width, FBTFT_ALPHA_MAX_WIDTH);
+        return -1;
+    }
+    
+    // 颜色和alpha共用一块内存
+    size_t pixels = (size_t)width * height;
+    uint8_t *block = (uint8_t *)fbtft_pool_calloc(pixels * (sizeof(uint16_t) + 1));
+    if (!block) {
+        fprintf(stderr, "Error: Cannot allocate alpha image\n");
+        return -1;
+    }
+    
+    image->color = (uint16_t *)block;
+    image->alpha = block + pixels * sizeof(uint16_t);
+    image->width = width;
+    image->height = height;
+    
+    if (fbtft_alpha_update_runs(image) != 0) {
+        fbtft_alpha_destroy(image);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * 释放图像
+ */
+void fbtft_alpha_destroy(fbtft_alpha_image_t *image) {
+    if (!image) return;
+    
+    fbtft_pool_free(image->color);
+    fbtft_pool_free(image->row_runs);
+    memset(image, 0, sizeof(*image));
+}
+
+/**
+ * 按当前alpha重新计算所有行的游程
+ * 先统计每行的游程数量，再一次分配整张表
+ */
+int fbtft_alpha_update_runs(fbtft_alpha_image_t *image) {
+    if (!image || !image->alpha) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    int width = image->width, height = image->height;
+    fbtft_alpha_run_t *row = (fbtft_alpha_run_t *)fbtft_pool_alloc((size_t)width * sizeof(fbtft_alpha_run_t));
+    if (!row) {
+        fprintf(stderr, "Error: Cannot allocate alpha runs\n");
+        return -1;
+    }
+    
+    size_t total = 0;
+    for (int y = 0; y < height; y++) {
+        total += (size_t)alpha_row_runs(image->alpha + (size_t)y * width, width, row);
+    }
+    
+    // 行索引表在前，游程紧跟在后
+    size_t index_bytes = (size_t)(height + 1) * sizeof(int);
+    int *row_runs = (int *)fbtft_pool_alloc(index_bytes + total * sizeof(fbtft_alpha_run_t));
+    if (!row_runs || total > INT32_MAX) {
+        fprintf(stderr, "Error: Cannot allocate alpha runs\n");
+        fbtft_pool_free(row_runs);
+        fbtft_pool_free(row);
+        return -1;
+    }
+    
+    fbtft_alpha_run_t *runs = (fbtft_alpha_run_t *)((uint8_t *)row_runs + index_bytes);
+    int count = 0;
+    for (int y = 0; y < height; y++) {
+        int n = alpha_row_runs(image->alpha + (size_t)y * width, width, row);
+        row_runs[y] = count;
+        memcpy(runs + count, row, (size_t)n * sizeof(fbtft_alpha_run_t));
+        count += n;
+    }
+    row_runs[height] = count;
+    
+    fbtft_pool_free(row);
+    fbtft_pool_free(image->row_runs);
+    image->row_runs = row_runs;
+    image->runs = runs;
+    image->run_count = count;
+    return 0;
+}
+
+/**
+ * 叠加区域中的 [begin, end) 行：不透明游程直接复制，半透明游程逐像素混合
+ */
+static void alpha_band(void *ctx, int begin, int end) {
+    const alpha_job_t *job = (const alpha_job_t *)ctx;
+    const fbtft_alpha_image_t *src = job->src;
+    int x_begin = job->rect.x;
+    int x_end = job->rect.x + job->rect.w;
+    
+    for (int j = begin; j < end; j++) {
+        int sy = job->rect.y + j;
+        const uint16_t *s = src->color + (size_t)sy * src->width;
+        const uint8_t *a = src->alpha + (size_t)sy * src->width;
+        uint16_t *d = fbtft_blit_row(job->dst, job->dst_stride, j);
+        uint8_t *da = job->dst_alpha ? job->dst_alpha + (size_t)j * job->dst_alpha_stride : NULL;
+        
+        for (int i = src->row_runs[sy]; i < src->row_runs[sy + 1]; i++) {
+            const fbtft_alpha_run_t *run = &src->runs[i];
+            int x0 = run->x > x_begin ? run->x : x_begin;
+            int x1 = run->x + run->length < x_end ? run->x + run->length : x_end;
+            if (run->x >= x_end) break;
+            if (x0 >= x1) continue;
+            
+            // 目标指针对应区域的第一列
+            int dx = x0 - x_begin;
+            if (run->opaque) {
+                memcpy(d + dx, s + x0, (size_t)(x1 - x0) * sizeof(uint16_t));
+                if (da) memset(da + dx, 255, (size_t)(x1 - x0));
+            } else if (da) {
+                fbtft_blit_blend_over_span(d + dx, da + dx, s + x0, a + x0, x1 - x0);
+            } else {
+                fbtft_blit_blend_span(d + dx, s + x0, a + x0, x1 - x0);
+            }
+        }
+    }
+}
+
+/**
+ * 求 (x, y, w, h) 与裁剪矩形的交集，没有交集时返回0
+ */
+static int alpha_clip(fbtft_rect_t *r, const fbtft_rect_t *clip) {
+    int x0 = r->x > clip->x ? r->x : clip->x;
+    int y0 = r->y > clip->y ? r->y : clip->y;
+    int x1 = r->x + r->w < clip->x + clip->w ? r->x + r->w : clip->x + clip->w;
+    int y1 = r->y + r->h < clip->y + clip->h ? r->y + r->h : clip->y + clip->h;
+    
+    if (x1 <= x0 || y1 <= y0) return 0;
+    r->x = x0;
+    r->y = y0;
+    r->w = x1 - x0;
+    r->h = y1 - y0;
+    return 1;
+}
+
+/**
+ * 把图像叠加到不透明的表面上，图像左上角位于 (x, y)
+ */
+void fbtft_alpha_blend(fbtft_surface_t *dst, int x, int y, const fbtft_alpha_image_t *src) {
+    if (!dst || !dst->pixels || !src || !src->color || !src->row_runs) return;
+    
+    fbtft_rect_t r = {x, y, src->width, src->height};
+    if (!alpha_clip(&r, &dst->clip)) return;
+    
+    alpha_job_t job;
+    job.src = src;
+    job.rect.x = r.x - x;
+    job.rect.y = r.y - y;
+    job.rect.w = r.w;
+    job.rect.h = r.h;
+    job.dst_stride = (size_t)dst->stride * sizeof(uint16_t);
+    job.dst = fbtft_blit_row(dst->pixels, job.dst_stride, r.y) + r.x;
+    job.dst_alpha = NULL;
+    job.dst_alpha_stride = 0;
+    
+    fbtft_parallel_rows(r.h, (size_t)r.w * sizeof(uint16_t), alpha_band, &job);
+}
+
+/**
+ * 把图像叠加到另一幅预乘alpha图像上，图像左上角位于 (x, y)
+ * @return 成功返回0，重新计算目标游程失败返回-1
+ */
+int fbtft_alpha_blend_over(fbtft_alpha_image_t *dst, int x, int y, const fbtft_alpha_image_t *src) {
+    if (!dst || !dst->color || !src || !src->color || !src->row_runs || dst == src) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    fbtft_rect_t r = {x, y, src->width, src->height};
+    fbtft_rect_t bounds = {0, 0, dst->width, dst->height};
+    if (!alpha_clip(&r, &bounds)) return 0;
+    
+    alpha_job_t job;
+    job.src = src;
+    job.rect.x = r.x - x;
+    job.rect.y = r.y - y;
+    job.rect.w = r.w;
+    job.rect.h = r.h;
+    job.dst_stride = (size_t)dst->width * sizeof(uint16_t);
+    job.dst = fbtft_blit_row(dst->color, job.dst_stride, r.y) + r.x;
+    job.dst_alpha = dst->alpha + (size_t)r.y * dst->width + r.x;
+    job.dst_alpha_stride = dst->width;
+    
+    fbtft_parallel_rows(r.h, (size_t)r.w * (sizeof(uint16_t) + 1), alpha_band, &job);
+    
+    return fbtft_alpha_update_runs(dst);
+}
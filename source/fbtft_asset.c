@@ -0,0 +1,242 @@
+#include "fbtft_asset.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define ALIGN_UP(x, a)  (((x) + (a) - 1) / (a) * (a))
+
+/**
+ * 映射资源文件并校验文件头
+ * 成功后 asset->pixels 直接指向映射内的像素数据
+ */
+int fbtft_asset_open(fbtft_asset_t *asset, const char *path) {
+    if (!asset || !path) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    memset(asset, 0, sizeof(*asset));
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open file %s\n", path);
+        return -1;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        perror("Error: Cannot stat asset file");
+        close(fd);
+        return -1;
+    }
+    
+    if ((size_t)st.st_size < sizeof(fbtft_asset_header_t)) {
+        fprintf(stderr, "Error: Cannot read asset header\n");
+        close(fd);
+        return -1;
+    }
+    
+    asset->map_size = (size_t)st.st_size;
+    asset->map = mmap(NULL, asset->map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // 映射建立后即可关闭文件描述符
+    if (asset->map == MAP_FAILED) {
+        perror("Error: Failed to mmap asset file");
+        asset->map = NULL;
+        return -1;
+    }
+    
+    // 像素数据会被整体顺序复制一次
+    madvise(asset->map, asset->map_size, MADV_SEQUENTIAL);
+    madvise(asset->map, asset->map_size, MADV_WILLNEED);
+    
+    fbtft_asset_header_t header;
+    memcpy(&header, asset->map, sizeof(header));
+    
+    if (memcmp(header.magic, FBTFT_ASSET_MAGIC, sizeof(header.magic)) != 0) {
+        fprintf(stderr, "Error: Not a valid RGB565 asset file\n");
+        fbtft_asset_close(asset);
+        return -1;
+    }
+    
+    if (header.version != FBTFT_ASSET_VERSION || header.format != FBTFT_ASSET_RGB565) {
+        fprintf(stderr, "Error: Unsupported asset version %u / format %u\n",
+                header.version, header.format);
+        fbtft_asset_close(asset);
+        return -1;
+    }
+    
+    if (header.width == 0 || header.height == 0 || header.width > INT32_MAX / 2 ||
+        header.stride < header.width * sizeof(uint16_t) ||
+        header.stride % FBTFT_ASSET_ALIGN != 0 || header.data_offset % FBTFT_ASSET_ALIGN != 0) {
+        fprintf(stderr, "Error: Invalid asset geometry\n");
+        fbtft_asset_close(asset);
+        return -1;
+    }
+    
+    // 像素数据必须完整地位于文件内
+    uint64_t data_size = (uint64_t)header.stride * header.height;
+    if (data_size > header.data_size ||
+        (uint64_t)header.data_offset + data_size > asset->map_size) {
+        fprintf(stderr, "Error: Cannot read asset pixel data\n");
+        fbtft_asset_close(asset);
+        return -1;
+    }
+    
+    asset->pixels = (const uint16_t *)((const uint8_t *)asset->map + header.data_offset);
+    asset->width = (int)header.width;
+    asset->height = (int)header.height;
+    asset->stride = (int)(header.stride / sizeof(uint16_t));
+    asset->format = (fbtft_asset_format_t)header.format;
+    return 0;
+}
+
+/**
+ * 解除资源文件映射
+ */
+void fbtft_asset_close(fbtft_asset_t *asset) {
+    if (!asset) return;
+    
+    if (asset->map) {
+        munmap(asset->map, asset->map_size);
+        asset->map = NULL;
+    }
+    asset->pixels = NULL;
+}
+
+/**
+ * 把资源直接复制到framebuffer
+ */
+int fbtft_asset_present(fbtft_lcd_t *lcd, const fbtft_asset_t *asset) {
+    if (!lcd || !asset || !asset->pixels) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    if (asset->width != lcd->width || asset->height != lcd->height) {
+        fprintf(stderr, "Error: Asset size %dx%d does not match LCD %dx%d\n",
+                asset->width, asset->height, lcd->width, lcd->height);
+        return -1;
+    }
+    
+    return fbtft_lcd_display_strided(lcd, asset->pixels, asset->stride, NULL);
+}
+
+/**
+ * 映射资源文件、显示并解除映射
+ */
+int fbtft_asset_show(fbtft_lcd_t *lcd, const char *path) {
+    fbtft_asset_t asset;
+    
+    if (fbtft_asset_open(&asset, path) != 0) {
+        return -1;
+    }
+    
+    int ret = fbtft_asset_present(lcd, &asset);
+    fbtft_asset_close(&asset);
+    return ret;
+}
+
+/**
+ * 写入资源文件
+ * 每行补齐到 FBTFT_ASSET_ALIGN 字节，补齐部分写0
+ */
+int fbtft_asset_write(const char *path, const uint16_t *pixels, int width, int height, int stride) {
+    if (!path || !pixels || width <= 0 || height <= 0 || stride < width) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    size_t row_bytes = (size_t)width * sizeof(uint16_t);
+    size_t out_stride = ALIGN_UP(row_bytes, FBTFT_ASSET_ALIGN);
+    
+    fbtft_asset_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, FBTFT_ASSET_MAGIC, sizeof(header.magic));
+    header.version = FBTFT_ASSET_VERSION;
+    header.format = FBTFT_ASSET_RGB565;
+    header.width = (uint32_t)width;
+    header.height = (uint32_t)height;
+    header.stride = (uint32_t)out_stride;
+    header.data_offset = ALIGN_UP(sizeof(header), FBTFT_ASSET_ALIGN);
+    header.data_size = (uint32_t)(out_stride * height);
+    
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot create file %s\n", path);
+        return -1;
+    }
+    
+    uint8_t *row = (uint8_t *)calloc(1, out_stride > header.data_offset ? out_stride : header.data_offset);
+    if (!row) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        fclose(file);
+        return -1;
+    }
+    
+    // 文件头之后补齐到像素数据偏移
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(row, 1, header.data_offset - sizeof(header), file) == header.data_offset - sizeof(header);
+    
+    for (int y = 0; ok && y < height; y++) {
+        memcpy(row, pixels + (size_t)y * stride, row_bytes);
+        ok = fwrite(row, 1, out_stride, file) == out_stride;
+    }
+    
+    free(row);
+    if (fclose(file) != 0) ok = 0;
+    
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to write asset file %s\n", path);
+        unlink(path);
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ * 把BMP转换为资源文件
+ * 先按旋转前的尺寸适配 (90/270度时宽高互换)，再旋转/镜像为framebuffer方向
+ * @param info 不为NULL时返回源图像信息 (取自解码用的同一次映射)
+ */
+int fbtft_asset_convert_bmp(const char *bmp_path, const char *asset_path,
+                            int panel_width, int panel_height, fit_mode_t fit,
+                            rotation_t rotation, mirror_t mirror, BMPInfo *info) {
+    if (!bmp_path || !asset_path || panel_width <= 0 || panel_height <= 0) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    int frame_width = panel_width;
+    int frame_height = panel_height;
+    if (rotation == ROTATE_90 || rotation == ROTATE_270) {
+        frame_width = panel_height;
+        frame_height = panel_width;
+    }
+    
+    size_t frame_pixels = (size_t)frame_width * frame_height;
+    uint16_t *frame = (uint16_t *)malloc(frame_pixels * sizeof(uint16_t));
+    uint16_t *panel = (uint16_t *)malloc(frame_pixels * sizeof(uint16_t));
+    if (!frame || !panel) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(frame);
+        free(panel);
+        return -1;
+    }
+    
+    int ret = bmp_load_fit_rotated(bmp_path, frame, frame_width, frame_height, fit, ROTATE_0, info);
+    
+    if (ret == 0) {
+        const uint16_t *out = frame;
+        if (rotation != ROTATE_0 || mirror != MIRROR_NONE) {
+            fbtft_lcd_transform_buffer(frame, panel, frame_width, frame_height, rotation, mirror);
+            out = panel;
+        }
+        ret = fbtft_asset_write(asset_path, out, panel_width, panel_height, panel_width);
+    }
+    
+    free(frame);
+    free(panel);
+    return ret;
+}
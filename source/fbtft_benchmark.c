@@ -12,223 +12,60 @@ void benchmark_signal_handler(int sig) {
 }
 
 /**
- * 获取当前时间（毫秒）
+ * 获取当前时间（毫秒，单调时钟）
  */
 unsigned long long get_current_time_ms(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (unsigned long long)(tv.tv_sec) * 1000 + (unsigned long long)(tv.tv_usec) / 1000;
+    return (unsigned long long)(fbtft_pacer_now_ns() / 1000000LL);
 }
 
 /**
  * 扫描 pic 目录获取所有 BMP 文件
+ * 只读取文件头校验，返回按文件名排序的前 max_images 个有效文件
  */
 int scan_bmp_files(ImageInfo images[], int max_images) {
-    DIR *dir;
-    struct dirent *entry;
+    fbtft_ingest_config_t ingest_config;
+    fbtft_ingest_result_t scan;
     int count = 0;
     
-    dir = opendir("./pic/");
-    if (dir == NULL) {
+    memset(&ingest_config, 0, sizeof(ingest_config));
+    ingest_config.target = FBTFT_INGEST_VALIDATE;
+    if (fbtft_ingest_dir("./pic/", &ingest_config, &scan) != 0) {
         printf("Error: Cannot open pic directory\n");
         return 0;
     }
     
     printf("Scanning BMP files in ./pic/ directory:\n");
     
-    while ((entry = readdir(dir)) != NULL && count < max_images) {
-        // 检查文件扩展名是否为 .bmp
-        int len = strlen(entry->d_name);
-        if (len > 4 && strcasecmp(&entry->d_name[len-4], ".bmp") == 0) {
-            // 使用更安全的路径拼接
-            int result = snprintf(images[count].path, MAX_PATH_LEN, "./pic/%s", entry->d_name);
-            if (result >= MAX_PATH_LEN) {
-                printf("Warning: Path too long for %s, skipping\n", entry->d_name);
-                continue;
-            }
-            images[count].valid = 1;
-            printf("  [%d] %s\n", count + 1, images[count].path);
-            count++;
+    for (int i = 0; i < scan.count && count < max_images; i++) {
+        if (scan.items[i].status != 0) {
+            printf("Warning: Invalid BMP file %s, skipping\n", scan.items[i].path);
+            continue;
+        }
+        // 使用更安全的路径拼接
+        int result = snprintf(images[count].path, MAX_PATH_LEN, "%s", scan.items[i].path);
+        if (result >= MAX_PATH_LEN) {
+            printf("Warning: Path too long for %s, skipping\n", scan.items[i].path);
+            continue;
         }
+        images[count].valid = 1;
+        printf("  [%d] %s\n", count + 1, images[count].path);
+        count++;
     }
     
-    closedir(dir);
+    fbtft_ingest_free(&scan);
     printf("Found %d BMP files\n\n", count);
     return count;
 }
 
-/**
- * 简单的5x7点阵字体数据 (ASCII 32-126)
- */
-static const unsigned char font_5x7[][7] = {
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ' ' (space)
-    {0x04, 0x04, 0x04, 0x04, 0x00, 0x04, 0x00}, // '!'
-    {0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00}, // '"'
-    {0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x00, 0x00}, // '#'
-    {0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04}, // '$'
-    {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}, // '%'
-    {0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D}, // '&'
-    {0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00}, // '''
-    {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}, // '('
-    {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}, // ')'
-    {0x00, 0x0A, 0x04, 0x1F, 0x04, 0x0A, 0x00}, // '*'
-    {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}, // '+'
-    {0x00, 0x00, 0x00, 0x00, 0x04, 0x04, 0x08}, // ','
-    {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}, // '-'
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00}, // '.'
-    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}, // '/'
-    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, // '0'
-    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, // '1'
-    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, // '2'
-    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}, // '3'
-    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, // '4'
-    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, // '5'
-    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, // '6'
-    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, // '7'
-    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, // '8'
-    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, // '9'
-    {0x00, 0x04, 0x00, 0x00, 0x04, 0x00, 0x00}, // ':'
-    {0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x08}, // ';'
-    {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02}, // '<'
-    {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}, // '='
-    {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08}, // '>'
-    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // '?'
-    {0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E}, // '@'
-    {0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11}, // 'A'
-    {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}, // 'B'
-    {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}, // 'C'
-    {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}, // 'D'
-    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}, // 'E'
-    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}, // 'F'
-    {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}, // 'G'
-    {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // 'H'
-    {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 'I'
-    {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}, // 'J'
-    {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}, // 'K'
-    {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}, // 'L'
-    {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}, // 'M'
-    {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}, // 'N'
-    {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'O'
-    {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}, // 'P'
-    {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}, // 'Q'
-    {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}, // 'R'
-    {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}, // 'S'
-    {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, // 'T'
-    {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'U'
-    {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}, // 'V'
-    {0x11, 0x11, 0x11, 0x15, 0x15, 0x1B, 0x11}, // 'W'
-    {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}, // 'X'
-    {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}, // 'Y'
-    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}, // 'Z'
-    {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // '['
-    {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00}, // '\'
-    {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E}, // ']'
-    {0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00}, // '^'
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F}, // '_'
-    {0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00}, // '`'
-    {0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F}, // 'a'
-    {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E}, // 'b'
-    {0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E}, // 'c'
-    {0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F}, // 'd'
-    {0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E}, // 'e'
-    {0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08}, // 'f'
-    {0x00, 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01}, // 'g'
-    {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11}, // 'h'
-    {0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E}, // 'i'
-    {0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C}, // 'j'
-    {0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12}, // 'k'
-    {0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 'l'
-    {0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11}, // 'm'
-    {0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11}, // 'n'
-    {0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E}, // 'o'
-    {0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10}, // 'p'
-    {0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01}, // 'q'
-    {0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10}, // 'r'
-    {0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E}, // 's'
-    {0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06}, // 't'
-    {0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D}, // 'u'
-    {0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04}, // 'v'
-    {0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A}, // 'w'
-    {0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11}, // 'x'
-    {0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E}, // 'y'
-    {0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F}, // 'z'
-};
-
 /**
  * 简单文本绘制函数
  */
 void draw_text_simple(uint16_t *buffer, int width, int height, int x, int y, 
                      const char *text, uint16_t color, uint16_t bg_color) {
-    int char_width = 6;   // 字符宽度 (5像素 + 1像素间距)
-    int char_height = 7;  // 字符高度
-    int len = strlen(text);
-    
-    // 边界检查
-    if (x < 0 || y < 0 || x >= width || y >= height) return;
-    
-    // 绘制背景矩形
-    int text_width = len * char_width;
-    int max_width = (x + text_width > width) ? width - x : text_width;
-    int max_height = (y + char_height > height) ? height - y : char_height;
-    
-    for (int dy = 0; dy < max_height; dy++) {
-        for (int dx = 0; dx < max_width; dx++) {
-            int px = x + dx;
-            int py = y + dy;
-            if (px >= 0 && px < width && py >= 0 && py < height) {
-                buffer[py * width + px] = bg_color;
-            }
-        }
-    }
+    fbtft_surface_t surface;
     
-    // 绘制每个字符
-    for (int i = 0; i < len && (x + i * char_width) < width; i++) {
-        char c = text[i];
-        int char_x = x + i * char_width;
-        
-        // 获取字符在字体表中的索引
-        int font_index = -1;
-        if (c >= 32 && c <= 122) { // 支持 ASCII 32-122 (空格到小写z)
-            font_index = c - 32;
-        }
-        
-        // 如果字符在支持范围内，绘制字符
-        if (font_index >= 0 && font_index < (int)(sizeof(font_5x7) / sizeof(font_5x7[0]))) {
-            const unsigned char *char_data = font_5x7[font_index];
-            
-            // 绘制字符的每一行
-            for (int row = 0; row < char_height && (y + row) < height; row++) {
-                unsigned char line_data = char_data[row];
-                
-                // 绘制字符的每一列
-                for (int col = 0; col < 5 && (char_x + col) < width; col++) {
-                    int px = char_x + col;
-                    int py = y + row;
-                    
-                    if (px >= 0 && py >= 0 && px < width && py < height) {
-                        // 检查当前位是否需要绘制
-                        if (line_data & (1 << (4 - col))) {
-                            buffer[py * width + px] = color;
-                        }
-                    }
-                }
-            }
-        } else {
-            // 不支持的字符，绘制一个方块
-            for (int row = 0; row < char_height && (y + row) < height; row++) {
-                for (int col = 0; col < 5 && (char_x + col) < width; col++) {
-                    int px = char_x + col;
-                    int py = y + row;
-                    
-                    if (px >= 0 && py >= 0 && px < width && py < height) {
-                        if (row == 0 || row == char_height - 1 || col == 0 || col == 4) {
-                            buffer[py * width + px] = color;
-                        }
-                    }
-                }
-            }
-        }
-    }
+    if (fbtft_surface_wrap(&surface, buffer, width, height, width) != 0) return;
+    fbtft_surface_draw_text(&surface, x, y, text, color, bg_color);
 }
 
 /**
@@ -236,90 +73,33 @@ void draw_text_simple(uint16_t *buffer, int width, int height, int x, int y,
  */
 void draw_text_landscape(uint16_t *buffer, int width, int height, int x, int y, 
                         const char *text, uint16_t color, uint16_t bg_color) {
-    int char_width = 6;   // 字符宽度 (5像素 + 1像素间距)
-    int char_height = 7;  // 字符高度
-    int len = strlen(text);
-    
-    // 在横屏模式下，文字从右向左，从上到下绘制
-    // 边界检查
-    if (x < 0 || y < 0 || x >= width || y >= height) return;
-    
-    // 计算旋转后的文字区域
-    int text_height = len * char_width;  // 横屏下文字的高度
-    int text_width = char_height;       // 横屏下文字的宽度
-    
-    // 绘制背景矩形
-    int max_width = (x + text_width > width) ? width - x : text_width;
-    int max_height = (y + text_height > height) ? height - y : text_height;
-    
-    for (int dy = 0; dy < max_height; dy++) {
-        for (int dx = 0; dx < max_width; dx++) {
-            int px = x + dx;
-            int py = y + dy;
-            if (px >= 0 && px < width && py >= 0 && py < height) {
-                buffer[py * width + px] = bg_color;
-            }
-        }
-    }
+    fbtft_surface_t surface;
     
-    // 绘制每个字符（旋转90度）
-    for (int i = 0; i < len && (y + i * char_width) < height; i++) {
-        char c = text[i];
-        int char_y = y + i * char_width;  // 横屏下字符的Y位置
-        
-        // 获取字符在字体表中的索引
-        int font_index = -1;
-        if (c >= 32 && c <= 122) { // 支持 ASCII 32-122
-            font_index = c - 32;
-        }
-        
-        // 如果字符在支持范围内，绘制字符
-        if (font_index >= 0 && font_index < (int)(sizeof(font_5x7) / sizeof(font_5x7[0]))) {
-            const unsigned char *char_data = font_5x7[font_index];
-            
-            // 绘制字符的每一行（旋转后变成列）
-            for (int row = 0; row < char_height && (x + row) < width; row++) {
-                unsigned char line_data = char_data[row];
-                
-                // 绘制字符的每一列（旋转后变成行）
-                for (int col = 0; col < 5 && (char_y + (4 - col)) < height; col++) {
-                    int px = x + row;
-                    int py = char_y + (4 - col);  // 逆序排列以实现旋转
-                    
-                    if (px >= 0 && py >= 0 && px < width && py < height) {
-                        // 检查当前位是否需要绘制
-                        if (line_data & (1 << (4 - col))) {
-                            buffer[py * width + px] = color;
-                        }
-                    }
-                }
-            }
-        } else {
-            // 不支持的字符，绘制一个方块
-            for (int row = 0; row < char_height && (x + row) < width; row++) {
-                for (int col = 0; col < 5 && (char_y + (4 - col)) < height; col++) {
-                    int px = x + row;
-                    int py = char_y + (4 - col);
-                    
-                    if (px >= 0 && py >= 0 && px < width && py < height) {
-                        if (row == 0 || row == char_height - 1 || col == 0 || col == 4) {
-                            buffer[py * width + px] = color;
-                        }
-                    }
-                }
-            }
-        }
-    }
+    if (fbtft_surface_wrap(&surface, buffer, width, height, width) != 0) return;
+    fbtft_surface_draw_text_vertical(&surface, x, y, text, color, bg_color);
 }
 
 /**
  * 显示FPS信息到屏幕
+ * 信息框在离屏表面上合成后只把信息框所在的区域刷新到LCD
  */
 void display_fps_info(fbtft_lcd_t *lcd, uint16_t *buffer, BenchmarkStats *stats) {
     char fps_text[64];
     char max_fps_text[64];
     char frames_text[64];
     char time_text[64];
+    fbtft_surface_t surface;
+    fbtft_damage_t damage;
+    
+    if (fbtft_surface_wrap(&surface, buffer, lcd->width, lcd->height, lcd->width) != 0) return;
+    fbtft_damage_reset(&damage);
+    
+    snprintf(fps_text, sizeof(fps_text), "FPS: %.1f", stats->current_fps);
+    snprintf(max_fps_text, sizeof(max_fps_text), "MAX: %.1f", stats->max_fps);
+    snprintf(frames_text, sizeof(frames_text), "Frames: %llu", stats->total_frames);
+    unsigned long long elapsed_time = stats->current_time_ms - stats->start_time_ms;
+    snprintf(time_text, sizeof(time_text), "Time: %llu.%llu s", 
+            elapsed_time / 1000, (elapsed_time % 1000) / 100);
     
     // 判断屏幕方向：如果宽度>高度为横屏，否则为竖屏
     int is_landscape = (lcd->width > lcd->height);
@@ -331,114 +111,92 @@ void display_fps_info(fbtft_lcd_t *lcd, uint16_t *buffer, BenchmarkStats *stats)
         int line_spacing = 60;         // 行间距
         
         // 清除信息显示区域
-        fbtft_lcd_fill_rectangle(lcd, info_x - 10, info_y, lcd->width - 1, 
-                                info_y + line_spacing * 4 + 30, FBTFT_WHITE);
-        
-        // 当前FPS
-        snprintf(fps_text, sizeof(fps_text), "FPS: %.1f", stats->current_fps);
-        draw_text_landscape(buffer, lcd->width, lcd->height, info_x, info_y, 
-                           fps_text, FBTFT_RED, FBTFT_WHITE);
-        
-        // 最高FPS
-        snprintf(max_fps_text, sizeof(max_fps_text), "MAX: %.1f", stats->max_fps);
-        draw_text_landscape(buffer, lcd->width, lcd->height, info_x, info_y + line_spacing, 
-                           max_fps_text, FBTFT_GREEN, FBTFT_WHITE);
+        int box_x = info_x - 10;
+        int box_h = line_spacing * 4 + 31;
+        fbtft_surface_fill_rect(&surface, box_x, info_y, lcd->width - box_x, box_h, FBTFT_WHITE);
+        fbtft_damage_add(&damage, box_x, info_y, lcd->width - box_x, box_h);
         
-        // 总帧数
-        snprintf(frames_text, sizeof(frames_text), "Frames: %llu", stats->total_frames);
-        draw_text_landscape(buffer, lcd->width, lcd->height, info_x, info_y + line_spacing * 2, 
-                           frames_text, FBTFT_BLUE, FBTFT_WHITE);
-        
-        // 运行时间
-        unsigned long long elapsed_time = stats->current_time_ms - stats->start_time_ms;
-        snprintf(time_text, sizeof(time_text), "Time: %llu.%llu s", 
-                elapsed_time / 1000, (elapsed_time % 1000) / 100);
-        draw_text_landscape(buffer, lcd->width, lcd->height, info_x, info_y + line_spacing * 3, 
-                           time_text, FBTFT_BLACK, FBTFT_WHITE);
+        fbtft_surface_draw_text_vertical(&surface, info_x, info_y, 
+                                         fps_text, FBTFT_RED, FBTFT_WHITE);
+        fbtft_surface_draw_text_vertical(&surface, info_x, info_y + line_spacing, 
+                                         max_fps_text, FBTFT_GREEN, FBTFT_WHITE);
+        fbtft_surface_draw_text_vertical(&surface, info_x, info_y + line_spacing * 2, 
+                                         frames_text, FBTFT_BLUE, FBTFT_WHITE);
+        fbtft_surface_draw_text_vertical(&surface, info_x, info_y + line_spacing * 3, 
+                                         time_text, FBTFT_BLACK, FBTFT_WHITE);
     } else {
         // 竖屏模式：在左上角水平显示信息
         int info_width = lcd->width - 20;
         int info_height = 80;
-        fbtft_lcd_fill_rectangle(lcd, 10, 10, 10 + info_width, 10 + info_height, FBTFT_WHITE);
+        fbtft_surface_fill_rect(&surface, 10, 10, info_width + 1, info_height + 1, FBTFT_WHITE);
+        fbtft_damage_add(&damage, 10, 10, info_width + 1, info_height + 1);
         
         int info_x = 10;
         int info_y = 15;
         int line_height = 16;
         
-        // 当前FPS
-        snprintf(fps_text, sizeof(fps_text), "FPS: %.1f", stats->current_fps);
-        draw_text_simple(buffer, lcd->width, lcd->height, info_x, info_y, 
-                        fps_text, FBTFT_RED, FBTFT_WHITE);
-        
-        // 最高FPS
-        snprintf(max_fps_text, sizeof(max_fps_text), "MAX: %.1f", stats->max_fps);
-        draw_text_simple(buffer, lcd->width, lcd->height, info_x, info_y + line_height, 
-                        max_fps_text, FBTFT_GREEN, FBTFT_WHITE);
-        
-        // 总帧数
-        snprintf(frames_text, sizeof(frames_text), "Frames: %llu", stats->total_frames);
-        draw_text_simple(buffer, lcd->width, lcd->height, info_x, info_y + line_height * 2, 
-                        frames_text, FBTFT_BLUE, FBTFT_WHITE);
-        
-        // 运行时间
-        unsigned long long elapsed_time = stats->current_time_ms - stats->start_time_ms;
-        snprintf(time_text, sizeof(time_text), "Time: %llu.%llu s", 
-                elapsed_time / 1000, (elapsed_time % 1000) / 100);
-        draw_text_simple(buffer, lcd->width, lcd->height, info_x, info_y + line_height * 3, 
-                        time_text, FBTFT_BLACK, FBTFT_WHITE);
+        fbtft_surface_draw_text(&surface, info_x, info_y, 
+                                fps_text, FBTFT_RED, FBTFT_WHITE);
+        fbtft_surface_draw_text(&surface, info_x, info_y + line_height, 
+                                max_fps_text, FBTFT_GREEN, FBTFT_WHITE);
+        fbtft_surface_draw_text(&surface, info_x, info_y + line_height * 2, 
+                                frames_text, FBTFT_BLUE, FBTFT_WHITE);
+        fbtft_surface_draw_text(&surface, info_x, info_y + line_height * 3, 
+                                time_text, FBTFT_BLACK, FBTFT_WHITE);
     }
+    
+    // 只刷新信息框区域
+    fbtft_surface_present(&surface, lcd, &damage);
 }
 
 /**
  * 显示最终结果
+ * 整个结果页在离屏表面上合成后一次性显示
  */
 void display_final_results(fbtft_lcd_t *lcd, uint16_t *buffer, BenchmarkStats *stats, int image_count) {
     char result_text[64];
+    fbtft_surface_t surface;
+    
+    if (fbtft_surface_wrap(&surface, buffer, lcd->width, lcd->height, lcd->width) != 0) return;
     
     // 清屏
-    fbtft_lcd_clear(lcd, FBTFT_WHITE);
+    fbtft_surface_clear(&surface, FBTFT_WHITE);
     
     int x = 20;
     int y = 30;
     int line_height = 25;
     
     // 标题
-    draw_text_simple(buffer, lcd->width, lcd->height, x, y, 
-                    "Benchmark Results", FBTFT_BLACK, FBTFT_WHITE);
+    fbtft_surface_draw_text(&surface, x, y, "Benchmark Results", FBTFT_BLACK, FBTFT_WHITE);
     y += line_height * 2;
     
     // 总帧数
     snprintf(result_text, sizeof(result_text), "Total Frames: %llu", stats->total_frames);
-    draw_text_simple(buffer, lcd->width, lcd->height, x, y, 
-                    result_text, FBTFT_BLUE, FBTFT_WHITE);
+    fbtft_surface_draw_text(&surface, x, y, result_text, FBTFT_BLUE, FBTFT_WHITE);
     y += line_height;
     
     // 运行时间
     unsigned long long elapsed_time = stats->current_time_ms - stats->start_time_ms;
     snprintf(result_text, sizeof(result_text), "Time: %.1f sec", (double)elapsed_time / 1000.0);
-    draw_text_simple(buffer, lcd->width, lcd->height, x, y, 
-                    result_text, FBTFT_BLUE, FBTFT_WHITE);
+    fbtft_surface_draw_text(&surface, x, y, result_text, FBTFT_BLUE, FBTFT_WHITE);
     y += line_height;
     
     // 平均FPS
     snprintf(result_text, sizeof(result_text), "Avg FPS: %.1f", stats->average_fps);
-    draw_text_simple(buffer, lcd->width, lcd->height, x, y, 
-                    result_text, FBTFT_GREEN, FBTFT_WHITE);
+    fbtft_surface_draw_text(&surface, x, y, result_text, FBTFT_GREEN, FBTFT_WHITE);
     y += line_height;
     
     // 最大FPS
     snprintf(result_text, sizeof(result_text), "Max FPS: %.1f", stats->max_fps);
-    draw_text_simple(buffer, lcd->width, lcd->height, x, y, 
-                    result_text, FBTFT_RED, FBTFT_WHITE);
+    fbtft_surface_draw_text(&surface, x, y, result_text, FBTFT_RED, FBTFT_WHITE);
     y += line_height;
     
     // 图像数量
     snprintf(result_text, sizeof(result_text), "Images: %d", image_count);
-    draw_text_simple(buffer, lcd->width, lcd->height, x, y, 
-                    result_text, FBTFT_BLACK, FBTFT_WHITE);
+    fbtft_surface_draw_text(&surface, x, y, result_text, FBTFT_BLACK, FBTFT_WHITE);
     
     // 显示到LCD
-    fbtft_lcd_display_buffer(lcd, buffer);
+    fbtft_surface_present(&surface, lcd, NULL);
 }
 
 /**
@@ -456,13 +214,19 @@ void print_progress(BenchmarkStats *stats) {
  */
 void fbtft_benchmark_run(const display_config_t *config) {
     fbtft_lcd_t lcd;
-    ImageInfo images[MAX_IMAGES];
+    fbtft_ingest_config_t ingest_config;
+    fbtft_ingest_result_t scan;
     BenchmarkStats stats = {0};
     int image_count = 0;
-    int current_image = 0;
     uint16_t *image_buffer = NULL;
-    uint16_t *transform_buffer = NULL;
-    BMPImage bmp_image;
+    fbtft_surface_t frame;
+    fbtft_image_cache_t image_cache;
+    fbtft_playlist_t playlist;
+    const char **image_paths = NULL;
+    fbtft_pacer_t pacer;
+    int paced = 0;
+    fbtft_pool_stats_t warm_pool;
+    int pool_warm = 0;
     
     // 设置信号处理器
     signal(SIGINT, benchmark_signal_handler);
@@ -470,10 +234,33 @@ void fbtft_benchmark_run(const display_config_t *config) {
     printf("=== FBTFT LCD Benchmark Test ===\n");
     printf("Press Ctrl+C to stop the benchmark\n\n");
     
-    // 扫描BMP文件
-    image_count = scan_bmp_files(images, MAX_IMAGES);
+    // 并行扫描BMP文件，只读取文件头校验，不限制图片数量
+    memset(&ingest_config, 0, sizeof(ingest_config));
+    ingest_config.target = FBTFT_INGEST_VALIDATE;
+    if (fbtft_ingest_dir("./pic/", &ingest_config, &scan) != 0) {
+        printf("Error: Cannot open pic directory\n");
+        return;
+    }
+    printf("Scanning BMP files in ./pic/ directory:\n");
+    fbtft_ingest_print_report(&scan, 1);
+    printf("\n");
+    
+    // 播放列表只包含有效文件，顺序与扫描结果相同 (按文件名排序)
+    image_paths = (const char **)malloc((size_t)(scan.count > 0 ? scan.count : 1) * sizeof(const char *));
+    if (!image_paths) {
+        printf("Error: Memory allocation failed\n");
+        fbtft_ingest_free(&scan);
+        return;
+    }
+    for (int i = 0; i < scan.count; i++) {
+        if (scan.items[i].status == 0) {
+            image_paths[image_count++] = scan.items[i].path;
+        }
+    }
     if (image_count == 0) {
         printf("Error: No BMP files found in ./pic/ directory\n");
+        free(image_paths);
+        fbtft_ingest_free(&scan);
         return;
     }
     
@@ -483,36 +270,50 @@ void fbtft_benchmark_run(const display_config_t *config) {
         fb_device = "/dev/fb0"; // 如果fb1不存在，尝试fb0
         if (fbtft_lcd_check_device(fb_device) == 0) {
             printf("Error: No framebuffer device found\n");
+            free(image_paths);
+            fbtft_ingest_free(&scan);
             return;
         }
     }
     
     if (fbtft_lcd_init(&lcd, fb_device) != 0) {
         printf("Error: Failed to initialize FBTFT LCD\n");
+        free(image_paths);
+        fbtft_ingest_free(&scan);
         return;
     }
     
     // 打印LCD信息
     fbtft_lcd_print_info(&lcd);
     
-    // 分配图像缓冲区
-    size_t buffer_size = lcd.width * lcd.height * sizeof(uint16_t);
-    image_buffer = (uint16_t *)malloc(buffer_size);
-    if (!image_buffer) {
+    // 旋转和镜像在提交时直接写入framebuffer
+    rotation_t rotation = config ? config->rotation : ROTATE_0;
+    mirror_t mirror = config ? config->mirror : MIRROR_NONE;
+    
+    // 分配离屏帧表面，每一帧都在上面合成后一次性显示
+    // 旋转90/270度时按旋转前的尺寸绘制，变换后正好是屏幕尺寸
+    int frame_width = lcd.width;
+    int frame_height = lcd.height;
+    if (rotation == ROTATE_90 || rotation == ROTATE_270) {
+        frame_width = lcd.height;
+        frame_height = lcd.width;
+    }
+    if (fbtft_surface_create(&frame, frame_width, frame_height) != 0) {
         printf("Error: Failed to allocate image buffer\n");
         fbtft_lcd_deinit(&lcd);
+        free(image_paths);
+        fbtft_ingest_free(&scan);
         return;
     }
+    image_buffer = frame.pixels;
     
-    // 如果需要旋转或镜像，分配变换缓冲区
-    if (config && (config->rotation != ROTATE_0 || config->mirror != MIRROR_NONE)) {
-        transform_buffer = (uint16_t *)malloc(buffer_size);
-        if (!transform_buffer) {
-            printf("Error: Failed to allocate transform buffer\n");
-            free(image_buffer);
-            fbtft_lcd_deinit(&lcd);
-            return;
-        }
+    // 解码并适配好的帧留在缓存中，循环播放时只需复制
+    if (fbtft_image_cache_init(&image_cache, IMAGE_CACHE_BYTES) != 0) {
+        fbtft_surface_destroy(&frame);
+        fbtft_lcd_deinit(&lcd);
+        free(image_paths);
+        fbtft_ingest_free(&scan);
+        return;
     }
     
     // 显示配置信息
@@ -523,69 +324,93 @@ void fbtft_benchmark_run(const display_config_t *config) {
         printf("  Mirror: %s\n", mirror_names[config->mirror]);
         const char *fit_names[] = {"scale", "stretch", "auto"};
         printf("  Fit Mode: %s\n", fit_names[config->fit_mode]);
+        if (config->target_fps > 0) {
+            printf("  Target FPS: %d\n", config->target_fps);
+        } else {
+            printf("  Target FPS: unlimited\n");
+        }
+        if (config->threads != 0) {
+            fbtft_threadpool_set_threads(config->threads < 0 ? 0 : config->threads);
+        }
+        printf("  Threads: %d\n", fbtft_threadpool_get_threads());
+        printf("  Prefetch: %d images\n", 
+               config->prefetch_depth > 0 ? config->prefetch_depth : FBTFT_PLAYLIST_DEFAULT_DEPTH);
         printf("\n");
     }
     
     // 清屏并显示启动信息
-    fbtft_lcd_clear(&lcd, FBTFT_WHITE);
-    draw_text_simple(image_buffer, lcd.width, lcd.height, 50, 100, 
-                    "FBTFT LCD Benchmark", FBTFT_BLACK, FBTFT_WHITE);
-    draw_text_simple(image_buffer, lcd.width, lcd.height, 70, 130, 
-                    "Starting...", FBTFT_RED, FBTFT_WHITE);
-    fbtft_lcd_display_buffer(&lcd, image_buffer);
+    fbtft_surface_clear(&frame, FBTFT_WHITE);
+    fbtft_surface_draw_text(&frame, 50, 100, "FBTFT LCD Benchmark", FBTFT_BLACK, FBTFT_WHITE);
+    fbtft_surface_draw_text(&frame, 70, 130, "Starting...", FBTFT_RED, FBTFT_WHITE);
+    fbtft_lcd_present_transformed(&lcd, frame.pixels, frame.width, frame.height, frame.stride, 
+                                  rotation, mirror, NULL);
     sleep(2);
     
+    // 后台线程预取并适配后面的图片，显示当前图片时下一张已经准备好
+    fbtft_playlist_config_t playlist_config;
+    memset(&playlist_config, 0, sizeof(playlist_config));
+    playlist_config.depth = config ? config->prefetch_depth : 0;
+    playlist_config.width = lcd.width;
+    playlist_config.height = lcd.height;
+    playlist_config.fit = config ? config->fit_mode : FIT_SCALE;
+    playlist_config.rotation = rotation;
+    playlist_config.loop = 1;
+    playlist_config.cache = &image_cache;
+    
+    // 开始播放前并行解码、适配缓存能容纳的前几张图片，第一轮播放直接命中缓存
+    int warm_count = (int)(IMAGE_CACHE_BYTES / ((size_t)lcd.width * lcd.height * sizeof(uint16_t)));
+    if (warm_count > image_count) warm_count = image_count;
+    if (warm_count > 0) {
+        fbtft_ingest_result_t warm;
+        memset(&ingest_config, 0, sizeof(ingest_config));
+        ingest_config.target = FBTFT_INGEST_CACHE;
+        ingest_config.width = lcd.width;
+        ingest_config.height = lcd.height;
+        ingest_config.fit = playlist_config.fit;
+        ingest_config.rotation = rotation;
+        ingest_config.cache = &image_cache;
+        if (fbtft_ingest_list(image_paths, warm_count, &ingest_config, &warm) == 0) {
+            printf("Preloading %d images into the image cache:\n", warm_count);
+            fbtft_ingest_print_report(&warm, 0);
+            printf("\n");
+        }
+        fbtft_ingest_free(&warm);
+    }
+    
+    if (fbtft_playlist_start(&playlist, image_paths, image_count, &playlist_config) != 0) {
+        fbtft_image_cache_deinit(&image_cache);
+        fbtft_surface_destroy(&frame);
+        fbtft_lcd_deinit(&lcd);
+        free(image_paths);
+        fbtft_ingest_free(&scan);
+        return;
+    }
+    
+    // 设置了目标帧率时按固定节奏提交帧，而不是全速渲染
+    if (config && config->target_fps > 0) {
+        paced = (fbtft_pacer_init(&pacer, &lcd, config->target_fps) == 0);
+    }
+    
     printf("Starting benchmark...\n");
     stats.start_time_ms = get_current_time_ms();
     stats.running = 1;
     
     // 主benchmark循环
     while (benchmark_running && stats.running) {
-        // 加载并显示当前图像
-        if (images[current_image].valid) {
-            // 清除缓冲区
-            memset(image_buffer, 0, buffer_size);
-            
-            // 尝试加载BMP图像
-            if (bmp_load(images[current_image].path, &bmp_image) == 0) {
-                // 根据适配模式选择加载方式
-                if (config && config->fit_mode == FIT_AUTO) {
-                    // 自动旋转以最佳适配
-                    bmp_convert_to_rgb565_smart_fit(&bmp_image, image_buffer, lcd.width, lcd.height, 1);
-                } else if (config && config->fit_mode == FIT_STRETCH) {
-                    // 拉伸填充整个屏幕
-                    bmp_convert_to_rgb565_smart_fit(&bmp_image, image_buffer, lcd.width, lcd.height, 0);
-                } else {
-                    // 默认保持宽高比缩放
-                    bmp_convert_to_rgb565(&bmp_image, image_buffer, lcd.width, lcd.height);
-                }
-                bmp_free(&bmp_image);
-                
-                // 应用图像变换（旋转和镜像）
-                if (config && transform_buffer && 
-                    (config->rotation != ROTATE_0 || config->mirror != MIRROR_NONE)) {
-                    
-                    // 将变换后的图像复制到变换缓冲区
-                    fbtft_lcd_transform_buffer(image_buffer, transform_buffer, 
-                                             lcd.width, lcd.height, 
-                                             config->rotation, config->mirror);
-                    
-                    // 将变换缓冲区的内容复制回图像缓冲区
-                    memcpy(image_buffer, transform_buffer, buffer_size);
-                }
-            } else {
+        // 取出预取好的下一张图像 (已按适配模式写满整个帧并旋转到屏幕方向)
+        const fbtft_playlist_frame_t *next = fbtft_playlist_next(&playlist);
+        if (next) {
+            if (next->status != 0) {
                 // BMP加载失败，显示错误信息
-                fbtft_lcd_clear(&lcd, FBTFT_WHITE);
-                draw_text_simple(image_buffer, lcd.width, lcd.height, 10, 50, 
-                               "Failed to load image", FBTFT_RED, FBTFT_WHITE);
+                fbtft_surface_clear(&frame, FBTFT_WHITE);
+                fbtft_surface_draw_text(&frame, 10, 50, "Failed to load image", FBTFT_RED, FBTFT_WHITE);
                 // 截断文件名以适应屏幕
                 char short_name[32];
-                const char *filename = strrchr(images[current_image].path, '/');
-                filename = filename ? filename + 1 : images[current_image].path;
+                const char *filename = strrchr(image_paths[next->index], '/');
+                filename = filename ? filename + 1 : image_paths[next->index];
                 strncpy(short_name, filename, sizeof(short_name) - 1);
                 short_name[sizeof(short_name) - 1] = '\0';
-                draw_text_simple(image_buffer, lcd.width, lcd.height, 10, 70, 
-                               short_name, FBTFT_RED, FBTFT_WHITE);
+                fbtft_surface_draw_text(&frame, 10, 70, short_name, FBTFT_RED, FBTFT_WHITE);
             }
             
             // 计算实时FPS
@@ -599,19 +424,37 @@ void fbtft_benchmark_run(const display_config_t *config) {
                 }
             }
             
+            // 等待到本帧的提交时刻
+            if (paced) {
+                fbtft_pacer_wait(&pacer);
+            }
+            
+            // 显示到LCD：预取的帧已经旋转，只剩镜像在写入framebuffer的同时完成；
+            // 错误信息绘制在旋转前的离屏表面上，旋转和镜像一起完成
+            if (next->status == 0) {
+                fbtft_lcd_present_transformed(&lcd, next->pixels, lcd.width, lcd.height, lcd.width, 
+                                              ROTATE_0, mirror, NULL);
+            } else {
+                fbtft_lcd_present_transformed(&lcd, frame.pixels, frame_width, frame_height, frame.stride, 
+                                              rotation, mirror, NULL);
+            }
+            
             // 显示FPS信息（每FPS_UPDATE_INTERVAL帧更新一次以减少开销）
+            // 信息框只刷新自身所在的区域
             if (stats.total_frames % FPS_UPDATE_INTERVAL == 0) {
                 display_fps_info(&lcd, image_buffer, &stats);
             }
-            
-            // 显示到LCD
-            fbtft_lcd_display_buffer(&lcd, image_buffer);
+        } else {
+            break;
         }
         
         stats.total_frames++;
         
-        // 切换到下一张图像
-        current_image = (current_image + 1) % image_count;
+        // 每张图片都至少解码过一次后记下堆分配次数，之后的帧应当不再分配
+        if (!pool_warm && stats.total_frames == (unsigned long long)image_count * 2) {
+            fbtft_pool_get_stats(&warm_pool);
+            pool_warm = 1;
+        }
         
         // 检查是否达到测试时间限制
         unsigned long long elapsed_time = stats.current_time_ms - stats.start_time_ms;
@@ -624,6 +467,8 @@ void fbtft_benchmark_run(const display_config_t *config) {
         print_progress(&stats);
     }
     
+    fbtft_playlist_stop(&playlist);
+    
     // 计算最终统计
     stats.current_time_ms = get_current_time_ms();
     unsigned long long total_time = stats.current_time_ms - stats.start_time_ms;
@@ -639,21 +484,129 @@ void fbtft_benchmark_run(const display_config_t *config) {
     printf("Average FPS: %.1f\n", stats.average_fps);
     printf("Maximum FPS: %.1f\n", stats.max_fps);
     printf("Images tested: %d\n", image_count);
+    fbtft_damage_stats_t damage_stats;
+    fbtft_lcd_get_damage_stats(&lcd, &damage_stats);
+    printf("Presents: %llu (%llu full frame), %.0f pixels/present\n", 
+           damage_stats.frames, damage_stats.full_frames, 
+           damage_stats.frames ? (double)damage_stats.pixels / damage_stats.frames : 0.0);
+    fbtft_scale_cache_stats_t scale_stats;
+    fbtft_scale_cache_get_stats(&scale_stats);
+    printf("Scale tables: %llu hits, %llu misses, %d cached (%zu bytes)\n", 
+           scale_stats.hits, scale_stats.misses, scale_stats.entries, scale_stats.bytes);
+    fbtft_image_cache_stats_t cache_stats;
+    fbtft_image_cache_get_stats(&image_cache, &cache_stats);
+    printf("Image cache: %llu hits, %llu misses, %llu evictions, %d cached (%zu/%zu bytes)\n", 
+           cache_stats.hits, cache_stats.misses, cache_stats.evictions, 
+           cache_stats.entries, cache_stats.bytes, cache_stats.budget);
     printf("FB Device: %s\n", lcd.device_path);
     printf("Resolution: %dx%d\n", lcd.width, lcd.height);
     printf("===============================\n");
+    fbtft_pool_stats_t pool_stats;
+    fbtft_pool_get_stats(&pool_stats);
+    printf("Buffer pool: %llu requests, %llu reused, %llu heap allocations", 
+           pool_stats.requests, pool_stats.reuses, pool_stats.heap_allocs);
+    if (pool_warm) {
+        printf(" (%llu after warm-up)", pool_stats.heap_allocs - warm_pool.heap_allocs);
+    }
+    printf(", %zu bytes idle\n", pool_stats.idle_bytes);
+    fbtft_playlist_print_stats(&playlist);
+    if (paced) {
+        fbtft_pacer_print_stats(&pacer);
+    }
     
     // 等待5秒显示结果
     sleep(5);
     
     // 清理资源
-    if (image_buffer) {
-        free(image_buffer);
-    }
-    if (transform_buffer) {
-        free(transform_buffer);
-    }
+    fbtft_image_cache_deinit(&image_cache);
+    fbtft_surface_destroy(&frame);
     fbtft_lcd_deinit(&lcd);
+    fbtft_threadpool_shutdown();
+    free(image_paths);
+    fbtft_ingest_free(&scan);
     
     printf("FBTFT Benchmark completed successfully!\n");
 }
+
+/**
+ * 逐像素旋转90度（未分块的参考实现，用于对比）
+ */
+static void naive_rotate_90(const uint16_t *src, uint16_t *dst, int src_width, int src_height) {
+    for (int y = 0; y < src_height; y++) {
+        for (int x = 0; x < src_width; x++) {
+            dst[(src_width - 1 - x) * src_height + y] = src[y * src_width + x];
+        }
+    }
+}
+
+/**
+ * 逐像素旋转270度（未分块的参考实现，用于对比）
+ */
+static void naive_rotate_270(const uint16_t *src, uint16_t *dst, int src_width, int src_height) {
+    for (int y = 0; y < src_height; y++) {
+        for (int x = 0; x < src_width; x++) {
+            dst[x * src_height + (src_height - 1 - y)] = src[y * src_width + x];
+        }
+    }
+}
+
+/**
+ * 旋转微基准：对比逐像素实现与分块旋转在不同分辨率下的耗时
+ */
+void fbtft_benchmark_rotation(void) {
+    static const int sizes[][2] = {
+        {240, 320}, {320, 240}, {480, 640}, {1280, 720}
+    };
+    
+    printf("=== Rotation Microbenchmark ===\n");
+    printf("%-10s %-5s %12s %12s %8s\n", "Size", "Rot", "Naive(us)", "Tiled(us)", "Speedup");
+    
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        int width = sizes[i][0];
+        int height = sizes[i][1];
+        size_t pixels = (size_t)width * height;
+        uint16_t *src = (uint16_t *)malloc(pixels * sizeof(uint16_t));
+        uint16_t *dst = (uint16_t *)malloc(pixels * sizeof(uint16_t));
+        if (!src || !dst) {
+            fprintf(stderr, "Error: Cannot allocate rotation benchmark buffers\n");
+            free(src);
+            free(dst);
+            return;
+        }
+        
+        for (size_t p = 0; p < pixels; p++) {
+            src[p] = (uint16_t)(p * 2654435761u >> 16);
+        }
+        
+        // 每个尺寸大约处理32M像素，保证计时稳定
+        int iterations = (int)((32u << 20) / pixels);
+        if (iterations < 4) iterations = 4;
+        
+        for (int rot = 0; rot < 2; rot++) {
+            long long start = fbtft_pacer_now_ns();
+            for (int it = 0; it < iterations; it++) {
+                if (rot == 0) naive_rotate_90(src, dst, width, height);
+                else naive_rotate_270(src, dst, width, height);
+            }
+            long long naive_ns = (fbtft_pacer_now_ns() - start) / iterations;
+            
+            start = fbtft_pacer_now_ns();
+            for (int it = 0; it < iterations; it++) {
+                if (rot == 0) fbtft_lcd_rotate_90(src, dst, width, height);
+                else fbtft_lcd_rotate_270(src, dst, width, height);
+            }
+            long long tiled_ns = (fbtft_pacer_now_ns() - start) / iterations;
+            
+            char size_str[16];
+            snprintf(size_str, sizeof(size_str), "%dx%d", width, height);
+            printf("%-10s %-5s %12.1f %12.1f %7.2fx\n", size_str, rot == 0 ? "90" : "270", 
+                   naive_ns / 1000.0, tiled_ns / 1000.0, 
+                   tiled_ns > 0 ? (double)naive_ns / tiled_ns : 0.0);
+        }
+        
+        free(src);
+        free(dst);
+    }
+    
+    printf("===============================\n");
+}
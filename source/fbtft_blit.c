@@ -0,0 +1,666 @@
+#include "fbtft_blit.h"
+#include "fbtft_threadpool.h"
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FBTFT_BLIT_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define FBTFT_BLIT_SSE2 1
+#endif
+
+// 小于该字节数的行直接内联复制，避免每行一次memcpy调用的开销
+#define BLIT_SHORT_ROW_BYTES    64
+
+// 转置分块大小：外层32x32的块保证源和目标的工作集都留在L1中，
+// 内层按8x8子块做向量转置
+#define BLIT_TRANSPOSE_TILE     32
+#define BLIT_TRANSPOSE_BLOCK    8
+
+/**
+ * 复制一段4字节对齐的短行
+ */
+static inline void copy_short_row_aligned(uint16_t *dst, const uint16_t *src, int width) {
+    fbtft_u32_alias_t *d = (fbtft_u32_alias_t *)dst;
+    const fbtft_u32_alias_t *s = (const fbtft_u32_alias_t *)src;
+    int words = width >> 1;
+    
+    for (int i = 0; i < words; i++) {
+        d[i] = s[i];
+    }
+    if (width & 1) {
+        dst[width - 1] = src[width - 1];
+    }
+}
+
+/**
+ * 按行复制像素块
+ * 行距相同且没有行填充时整块一次复制；短行且4字节对齐时内联复制；其余逐行memcpy
+ */
+void fbtft_blit_copy(uint16_t *dst, size_t dst_stride, 
+                     const uint16_t *src, size_t src_stride, 
+                     int width, int height) {
+    if (!dst || !src || width <= 0 || height <= 0) return;
+    
+    size_t row_bytes = (size_t)width * sizeof(uint16_t);
+    
+    // 两边都是连续存储，一次复制完成
+    if (dst_stride == row_bytes && src_stride == row_bytes) {
+        memcpy(dst, src, row_bytes * height);
+        return;
+    }
+    
+    const uint8_t *s = (const uint8_t *)src;
+    uint8_t *d = (uint8_t *)dst;
+    
+    if (row_bytes < BLIT_SHORT_ROW_BYTES &&
+        (((uintptr_t)s | (uintptr_t)d | src_stride | dst_stride) & 3) == 0) {
+        for (int y = 0; y < height; y++) {
+            copy_short_row_aligned((uint16_t *)d, (const uint16_t *)s, width);
+            s += src_stride;
+            d += dst_stride;
+        }
+        return;
+    }
+    
+    for (int y = 0; y < height; y++) {
+        memcpy(d, s, row_bytes);
+        s += src_stride;
+        d += dst_stride;
+    }
+}
+
+/**
+ * 标量填充：先对齐到8字节，再用64位打包写入，每次4个像素
+ */
+static inline void fill_span_scalar(uint16_t *dst, int count, uint16_t color) {
+    uint32_t pattern32 = ((uint32_t)color << 16) | color;
+    uint64_t pattern64 = ((uint64_t)pattern32 << 32) | pattern32;
+    
+    // 对齐到4字节
+    if (((uintptr_t)dst & 2) && count > 0) {
+        *dst++ = color;
+        count--;
+    }
+    // 对齐到8字节
+    if (((uintptr_t)dst & 4) && count >= 2) {
+        *(fbtft_u32_alias_t *)dst = pattern32;
+        dst += 2;
+        count -= 2;
+    }
+    
+    fbtft_u64_alias_t *d = (fbtft_u64_alias_t *)dst;
+    while (count >= 16) {
+        d[0] = pattern64;
+        d[1] = pattern64;
+        d[2] = pattern64;
+        d[3] = pattern64;
+        d += 4;
+        count -= 16;
+    }
+    while (count >= 4) {
+        *d++ = pattern64;
+        count -= 4;
+    }
+    
+    dst = (uint16_t *)d;
+    while (count-- > 0) {
+        *dst++ = color;
+    }
+}
+
+/**
+ * 填充一段连续像素
+ * 短段直接走标量路径；长段先用标量对齐到16字节，再用向量写入
+ */
+void fbtft_blit_fill_span(uint16_t *dst, int count, uint16_t color) {
+    if (!dst || count <= 0) return;
+    
+#if defined(FBTFT_BLIT_NEON) || defined(FBTFT_BLIT_SSE2)
+    if (count >= 32) {
+        int head = (int)((16 - ((uintptr_t)dst & 15)) & 15) / 2;
+        fill_span_scalar(dst, head, color);
+        dst += head;
+        count -= head;
+        
+#if defined(FBTFT_BLIT_NEON)
+        uint16x8_t v = vdupq_n_u16(color);
+        while (count >= 16) {
+            vst1q_u16(dst, v);
+            vst1q_u16(dst + 8, v);
+            dst += 16;
+            count -= 16;
+        }
+        if (count >= 8) {
+            vst1q_u16(dst, v);
+            dst += 8;
+            count -= 8;
+        }
+#else
+        __m128i v = _mm_set1_epi16((short)color);
+        while (count >= 16) {
+            _mm_store_si128((__m128i *)dst, v);
+            _mm_store_si128((__m128i *)(dst + 8), v);
+            dst += 16;
+            count -= 16;
+        }
+        if (count >= 8) {
+            _mm_store_si128((__m128i *)dst, v);
+            dst += 8;
+            count -= 8;
+        }
+#endif
+    }
+#endif
+    
+    fill_span_scalar(dst, count, color);
+}
+
+// 填充任务 (按行分条带)
+typedef struct {
+    uint16_t *dst;
+    size_t stride;
+    int width;
+    uint16_t color;
+} fill_job_t;
+
+/**
+ * 填充 [begin, end) 行；行间没有填充字节时整个条带作为一段连续像素填充
+ */
+static void fill_band(void *ctx, int begin, int end) {
+    const fill_job_t *job = (const fill_job_t *)ctx;
+    uint8_t *d = (uint8_t *)fbtft_blit_row(job->dst, job->stride, begin);
+    
+    if (job->stride == (size_t)job->width * sizeof(uint16_t)) {
+        fbtft_blit_fill_span((uint16_t *)d, job->width * (end - begin), job->color);
+        return;
+    }
+    
+    for (int y = begin; y < end; y++) {
+        fbtft_blit_fill_span((uint16_t *)d, job->width, job->color);
+        d += job->stride;
+    }
+}
+
+/**
+ * 用单一颜色填充像素块
+ * 没有行填充时把整块当作一段处理
+ */
+void fbtft_blit_fill(uint16_t *dst, size_t dst_stride, int width, int height, uint16_t color) {
+    if (!dst || width <= 0 || height <= 0) return;
+    
+    // 单像素宽的竖线不值得走span内核
+    if (width == 1) {
+        uint8_t *d = (uint8_t *)dst;
+        for (int y = 0; y < height; y++) {
+            *(uint16_t *)d = color;
+            d += dst_stride;
+        }
+        return;
+    }
+    
+    fill_job_t job = {dst, dst_stride, width, color};
+    fbtft_parallel_rows(height, (size_t)width * sizeof(uint16_t), fill_band, &job);
+}
+
+/**
+ * 标量转置一个源矩形区域 [x0, x1) x [y0, y1)
+ * 以源列为外层循环，每个源列对应目标的一行连续写入
+ */
+static void transpose_rect_scalar(uint16_t *dst, size_t dst_stride, 
+                                  const uint16_t *src, size_t src_stride, 
+                                  int src_width, int src_height, int ops, 
+                                  int x0, int y0, int x1, int y1) {
+    for (int x = x0; x < x1; x++) {
+        // 源列x -> 目标行 (FLIP_Y时倒序)
+        uint16_t *d = fbtft_blit_row(dst, dst_stride, 
+                                     (ops & FBTFT_BLIT_FLIP_Y) ? src_width - 1 - x : x);
+        if (ops & FBTFT_BLIT_FLIP_X) {
+            d += src_height - 1;
+            for (int y = y0; y < y1; y++) {
+                d[-y] = fbtft_blit_row_const(src, src_stride, y)[x];
+            }
+        } else {
+            for (int y = y0; y < y1; y++) {
+                d[y] = fbtft_blit_row_const(src, src_stride, y)[x];
+            }
+        }
+    }
+}
+
+#if defined(FBTFT_BLIT_NEON)
+// 反转8个16位通道的顺序
+static inline uint16x8_t reverse_u16x8(uint16x8_t v) {
+    v = vrev64q_u16(v);
+    return vcombine_u16(vget_high_u16(v), vget_low_u16(v));
+}
+
+/**
+ * NEON: 8x8块转置后写入目标 (16位通道)
+ */
+static inline void transpose_block8(uint16_t *dst, size_t dst_stride, 
+                                    const uint16_t *src, size_t src_stride, 
+                                    int src_width, int src_height, int ops, 
+                                    int bx, int by) {
+    uint16x8_t r[8];
+    uint16x8_t col[8];
+    
+    for (int i = 0; i < 8; i++) {
+        r[i] = vld1q_u16(fbtft_blit_row_const(src, src_stride, by + i) + bx);
+    }
+    
+    // 第一步：相邻两行按16位交错
+    uint16x8x2_t t01 = vtrnq_u16(r[0], r[1]);
+    uint16x8x2_t t23 = vtrnq_u16(r[2], r[3]);
+    uint16x8x2_t t45 = vtrnq_u16(r[4], r[5]);
+    uint16x8x2_t t67 = vtrnq_u16(r[6], r[7]);
+    
+    // 第二步：按32位交错
+    uint32x4x2_t a0 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]), vreinterpretq_u32_u16(t23.val[0]));
+    uint32x4x2_t a1 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]), vreinterpretq_u32_u16(t23.val[1]));
+    uint32x4x2_t b0 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]), vreinterpretq_u32_u16(t67.val[0]));
+    uint32x4x2_t b1 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]), vreinterpretq_u32_u16(t67.val[1]));
+    
+    // 第三步：交换64位半部分，得到8个源列
+    col[0] = vcombine_u16(vget_low_u16(vreinterpretq_u16_u32(a0.val[0])), vget_low_u16(vreinterpretq_u16_u32(b0.val[0])));
+    col[4] = vcombine_u16(vget_high_u16(vreinterpretq_u16_u32(a0.val[0])), vget_high_u16(vreinterpretq_u16_u32(b0.val[0])));
+    col[2] = vcombine_u16(vget_low_u16(vreinterpretq_u16_u32(a0.val[1])), vget_low_u16(vreinterpretq_u16_u32(b0.val[1])));
+    col[6] = vcombine_u16(vget_high_u16(vreinterpretq_u16_u32(a0.val[1])), vget_high_u16(vreinterpretq_u16_u32(b0.val[1])));
+    col[1] = vcombine_u16(vget_low_u16(vreinterpretq_u16_u32(a1.val[0])), vget_low_u16(vreinterpretq_u16_u32(b1.val[0])));
+    col[5] = vcombine_u16(vget_high_u16(vreinterpretq_u16_u32(a1.val[0])), vget_high_u16(vreinterpretq_u16_u32(b1.val[0])));
+    col[3] = vcombine_u16(vget_low_u16(vreinterpretq_u16_u32(a1.val[1])), vget_low_u16(vreinterpretq_u16_u32(b1.val[1])));
+    col[7] = vcombine_u16(vget_high_u16(vreinterpretq_u16_u32(a1.val[1])), vget_high_u16(vreinterpretq_u16_u32(b1.val[1])));
+    
+    for (int i = 0; i < 8; i++) {
+        int row = (ops & FBTFT_BLIT_FLIP_Y) ? src_width - 1 - (bx + i) : bx + i;
+        if (ops & FBTFT_BLIT_FLIP_X) {
+            vst1q_u16(fbtft_blit_row(dst, dst_stride, row) + (src_height - 8 - by), reverse_u16x8(col[i]));
+        } else {
+            vst1q_u16(fbtft_blit_row(dst, dst_stride, row) + by, col[i]);
+        }
+    }
+}
+#elif defined(FBTFT_BLIT_SSE2)
+// 反转8个16位通道的顺序
+static inline __m128i reverse_u16x8(__m128i v) {
+    v = _mm_shufflelo_epi16(v, 0x1B);
+    v = _mm_shufflehi_epi16(v, 0x1B);
+    return _mm_shuffle_epi32(v, 0x4E);
+}
+
+/**
+ * SSE2: 8x8块转置后写入目标 (16位通道)
+ */
+static inline void transpose_block8(uint16_t *dst, size_t dst_stride, 
+                                    const uint16_t *src, size_t src_stride, 
+                                    int src_width, int src_height, int ops, 
+                                    int bx, int by) {
+    __m128i r[8];
+    __m128i col[8];
+    
+    for (int i = 0; i < 8; i++) {
+        r[i] = _mm_loadu_si128((const __m128i *)(fbtft_blit_row_const(src, src_stride, by + i) + bx));
+    }
+    
+    // 第一步：相邻两行按16位交错
+    __m128i b0 = _mm_unpacklo_epi16(r[0], r[1]);
+    __m128i b1 = _mm_unpackhi_epi16(r[0], r[1]);
+    __m128i b2 = _mm_unpacklo_epi16(r[2], r[3]);
+    __m128i b3 = _mm_unpackhi_epi16(r[2], r[3]);
+    __m128i b4 = _mm_unpacklo_epi16(r[4], r[5]);
+    __m128i b5 = _mm_unpackhi_epi16(r[4], r[5]);
+    __m128i b6 = _mm_unpacklo_epi16(r[6], r[7]);
+    __m128i b7 = _mm_unpackhi_epi16(r[6], r[7]);
+    
+    // 第二步：按32位交错
+    __m128i c0 = _mm_unpacklo_epi32(b0, b2);
+    __m128i c1 = _mm_unpackhi_epi32(b0, b2);
+    __m128i c2 = _mm_unpacklo_epi32(b1, b3);
+    __m128i c3 = _mm_unpackhi_epi32(b1, b3);
+    __m128i c4 = _mm_unpacklo_epi32(b4, b6);
+    __m128i c5 = _mm_unpackhi_epi32(b4, b6);
+    __m128i c6 = _mm_unpacklo_epi32(b5, b7);
+    __m128i c7 = _mm_unpackhi_epi32(b5, b7);
+    
+    // 第三步：按64位交错，得到8个源列
+    col[0] = _mm_unpacklo_epi64(c0, c4);
+    col[1] = _mm_unpackhi_epi64(c0, c4);
+    col[2] = _mm_unpacklo_epi64(c1, c5);
+    col[3] = _mm_unpackhi_epi64(c1, c5);
+    col[4] = _mm_unpacklo_epi64(c2, c6);
+    col[5] = _mm_unpackhi_epi64(c2, c6);
+    col[6] = _mm_unpacklo_epi64(c3, c7);
+    col[7] = _mm_unpackhi_epi64(c3, c7);
+    
+    for (int i = 0; i < 8; i++) {
+        int row = (ops & FBTFT_BLIT_FLIP_Y) ? src_width - 1 - (bx + i) : bx + i;
+        if (ops & FBTFT_BLIT_FLIP_X) {
+            _mm_storeu_si128((__m128i *)(fbtft_blit_row(dst, dst_stride, row) + (src_height - 8 - by)), 
+                             reverse_u16x8(col[i]));
+        } else {
+            _mm_storeu_si128((__m128i *)(fbtft_blit_row(dst, dst_stride, row) + by), col[i]);
+        }
+    }
+}
+#endif
+
+/**
+ * 转置类变换 (90/270度旋转、主/副对角线翻转)
+ * 外层按32x32分块遍历，块内完整的8x8子块走向量转置，边缘剩余部分走标量
+ * 只处理源图像的 [y_begin, y_end) 行，y_begin 须按分块对齐
+ */
+static void transpose_tiled(uint16_t *dst, size_t dst_stride, 
+                            const uint16_t *src, size_t src_stride, 
+                            int src_width, int src_height, int ops, 
+                            int y_begin, int y_end) {
+    for (int ty = y_begin; ty < y_end; ty += BLIT_TRANSPOSE_TILE) {
+        int ty_end = ty + BLIT_TRANSPOSE_TILE < y_end ? ty + BLIT_TRANSPOSE_TILE : y_end;
+        
+        for (int tx = 0; tx < src_width; tx += BLIT_TRANSPOSE_TILE) {
+            int tx_end = tx + BLIT_TRANSPOSE_TILE < src_width ? tx + BLIT_TRANSPOSE_TILE : src_width;
+            
+#if defined(FBTFT_BLIT_NEON) || defined(FBTFT_BLIT_SSE2)
+            // 块内完整的8x8子块
+            int full_y = ty + ((ty_end - ty) / BLIT_TRANSPOSE_BLOCK) * BLIT_TRANSPOSE_BLOCK;
+            int full_x = tx + ((tx_end - tx) / BLIT_TRANSPOSE_BLOCK) * BLIT_TRANSPOSE_BLOCK;
+            
+            for (int by = ty; by < full_y; by += BLIT_TRANSPOSE_BLOCK) {
+                for (int bx = tx; bx < full_x; bx += BLIT_TRANSPOSE_BLOCK) {
+                    transpose_block8(dst, dst_stride, src, src_stride, 
+                                     src_width, src_height, ops, bx, by);
+                }
+            }
+            
+            // 右侧和下方不足8像素的边缘
+            if (full_x < tx_end) {
+                transpose_rect_scalar(dst, dst_stride, src, src_stride, src_width, src_height, 
+                                      ops, full_x, ty, tx_end, ty_end);
+            }
+            if (full_y < ty_end) {
+                transpose_rect_scalar(dst, dst_stride, src, src_stride, src_width, src_height, 
+                                      ops, tx, full_y, full_x, ty_end);
+            }
+#else
+            transpose_rect_scalar(dst, dst_stride, src, src_stride, src_width, src_height, 
+                                  ops, tx, ty, tx_end, ty_end);
+#endif
+        }
+    }
+}
+
+/**
+ * 将一行像素倒序写入目标行
+ */
+static void reverse_row(uint16_t *dst, const uint16_t *src, int count) {
+    int i = 0;
+    
+#if defined(FBTFT_BLIT_NEON)
+    for (; i + 8 <= count; i += 8) {
+        vst1q_u16(dst + count - 8 - i, reverse_u16x8(vld1q_u16(src + i)));
+    }
+#elif defined(FBTFT_BLIT_SSE2)
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_si128((__m128i *)(dst + count - 8 - i), 
+                         reverse_u16x8(_mm_loadu_si128((const __m128i *)(src + i))));
+    }
+#endif
+    
+    for (; i < count; i++) {
+        dst[count - 1 - i] = src[i];
+    }
+}
+
+// 几何变换任务
+typedef struct {
+    uint16_t *dst;
+    size_t dst_stride;
+    const uint16_t *src;
+    size_t src_stride;
+    int src_width;
+    int src_height;
+    int ops;
+} transform_job_t;
+
+/**
+ * 变换源图像的一个条带
+ * 转置类操作以32行的分块行为单位，其余操作以源行为单位
+ * 非转置操作按预先计算好的目标起始行和行步进逐行处理：
+ * FLIP_Y为整行复制倒序排列，FLIP_X为行内反转
+ */
+static void transform_band(void *ctx, int begin, int end) {
+    const transform_job_t *job = (const transform_job_t *)ctx;
+    
+    if (job->ops & FBTFT_BLIT_TRANSPOSE) {
+        int y_end = end * BLIT_TRANSPOSE_TILE;
+        transpose_tiled(job->dst, job->dst_stride, job->src, job->src_stride, 
+                        job->src_width, job->src_height, job->ops, 
+                        begin * BLIT_TRANSPOSE_TILE, y_end < job->src_height ? y_end : job->src_height);
+        return;
+    }
+    
+    // 目标起始行与行步进
+    uint8_t *d;
+    ptrdiff_t d_step = (ptrdiff_t)job->dst_stride;
+    if (job->ops & FBTFT_BLIT_FLIP_Y) {
+        d = (uint8_t *)fbtft_blit_row(job->dst, job->dst_stride, job->src_height - 1 - begin);
+        d_step = -d_step;
+    } else {
+        d = (uint8_t *)fbtft_blit_row(job->dst, job->dst_stride, begin);
+    }
+    
+    const uint8_t *s = (const uint8_t *)fbtft_blit_row_const(job->src, job->src_stride, begin);
+    size_t row_bytes = (size_t)job->src_width * sizeof(uint16_t);
+    
+    for (int y = begin; y < end; y++) {
+        if (job->ops & FBTFT_BLIT_FLIP_X) {
+            reverse_row((uint16_t *)d, (const uint16_t *)s, job->src_width);
+        } else {
+            memcpy(d, s, row_bytes);
+        }
+        d += d_step;
+        s += job->src_stride;
+    }
+}
+
+/**
+ * 将旋转+镜像组合化简为一次几何变换
+ * 旋转先作用于源图像，镜像再作用于旋转后的图像，镜像只需翻转目标坐标轴
+ */
+int fbtft_blit_transform_ops(rotation_t rotation, mirror_t mirror) {
+    int ops = 0;
+    
+    switch (rotation) {
+        case ROTATE_90:
+            ops = FBTFT_BLIT_TRANSPOSE | FBTFT_BLIT_FLIP_Y;
+            break;
+        case ROTATE_180:
+            ops = FBTFT_BLIT_FLIP_X | FBTFT_BLIT_FLIP_Y;
+            break;
+        case ROTATE_270:
+            ops = FBTFT_BLIT_TRANSPOSE | FBTFT_BLIT_FLIP_X;
+            break;
+        case ROTATE_0:
+        default:
+            break;
+    }
+    
+    if (mirror == MIRROR_HORIZONTAL || mirror == MIRROR_BOTH) {
+        ops ^= FBTFT_BLIT_FLIP_X;
+    }
+    if (mirror == MIRROR_VERTICAL || mirror == MIRROR_BOTH) {
+        ops ^= FBTFT_BLIT_FLIP_Y;
+    }
+    
+    return ops;
+}
+
+/**
+ * 单遍几何变换，按源图像的水平条带分给线程池
+ */
+void fbtft_blit_transform(uint16_t *dst, size_t dst_stride, 
+                          const uint16_t *src, size_t src_stride, 
+                          int src_width, int src_height, int ops) {
+    if (!dst || !src || src_width <= 0 || src_height <= 0) return;
+    
+    if (!(ops & (FBTFT_BLIT_TRANSPOSE | FBTFT_BLIT_FLIP_X | FBTFT_BLIT_FLIP_Y))) {
+        fbtft_blit_copy(dst, dst_stride, src, src_stride, src_width, src_height);
+        return;
+    }
+    
+    transform_job_t job = {dst, dst_stride, src, src_stride, src_width, src_height, ops};
+    size_t row_bytes = (size_t)src_width * sizeof(uint16_t);
+    
+    if (ops & FBTFT_BLIT_TRANSPOSE) {
+        int tile_rows = (src_height + BLIT_TRANSPOSE_TILE - 1) / BLIT_TRANSPOSE_TILE;
+        fbtft_parallel_rows(tile_rows, row_bytes * BLIT_TRANSPOSE_TILE, transform_band, &job);
+    } else {
+        fbtft_parallel_rows(src_height, row_bytes, transform_band, &job);
+    }
+}
+
+/**
+ * v / 255 四舍五入 (v <= 65535 时精确)
+ */
+static inline uint32_t blend_div255(uint32_t v) {
+    v += 128;
+    return (v + (v >> 8)) >> 8;
+}
+
+/**
+ * 一个预乘像素叠加到目标像素上：d = s + d * (255 - a) / 255，各通道饱和到最大值
+ */
+static inline uint16_t blend_pixel(uint16_t d, uint16_t s, uint32_t inv) {
+    uint32_t r = (uint32_t)(s >> 11) + blend_div255((uint32_t)(d >> 11) * inv);
+    uint32_t g = (uint32_t)((s >> 5) & 0x3F) + blend_div255((uint32_t)((d >> 5) & 0x3F) * inv);
+    uint32_t b = (uint32_t)(s & 0x1F) + blend_div255((uint32_t)(d & 0x1F) * inv);
+    
+    if (r > 0x1F) r = 0x1F;
+    if (g > 0x3F) g = 0x3F;
+    if (b > 0x1F) b = 0x1F;
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+#if defined(FBTFT_BLIT_NEON)
+static inline uint16x8_t neon_div255(uint16x8_t v) {
+    v = vaddq_u16(v, vdupq_n_u16(128));
+    return vshrq_n_u16(vsraq_n_u16(v, v, 8), 8);
+}
+
+/**
+ * 8个预乘像素叠加到目标像素上，inv 为 255 - alpha
+ */
+static inline uint16x8_t neon_blend8(uint16x8_t d, uint16x8_t s, uint16x8_t inv) {
+    const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+    const uint16x8_t mask6 = vdupq_n_u16(0x3F);
+    
+    uint16x8_t r = vaddq_u16(vshrq_n_u16(s, 11), neon_div255(vmulq_u16(vshrq_n_u16(d, 11), inv)));
+    uint16x8_t g = vaddq_u16(vandq_u16(vshrq_n_u16(s, 5), mask6), 
+                             neon_div255(vmulq_u16(vandq_u16(vshrq_n_u16(d, 5), mask6), inv)));
+    uint16x8_t b = vaddq_u16(vandq_u16(s, mask5), neon_div255(vmulq_u16(vandq_u16(d, mask5), inv)));
+    
+    r = vminq_u16(r, mask5);
+    g = vminq_u16(g, mask6);
+    b = vminq_u16(b, mask5);
+    return vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b);
+}
+#elif defined(FBTFT_BLIT_SSE2)
+static inline __m128i sse2_div255(__m128i v) {
+    v = _mm_add_epi16(v, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(v, _mm_srli_epi16(v, 8)), 8);
+}
+
+/**
+ * 8个预乘像素叠加到目标像素上，inv 为 255 - alpha
+ * 各通道乘积不超过 63 * 255，16位有符号运算不会溢出
+ */
+static inline __m128i sse2_blend8(__m128i d, __m128i s, __m128i inv) {
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+    const __m128i mask6 = _mm_set1_epi16(0x3F);
+    
+    __m128i r = _mm_add_epi16(_mm_srli_epi16(s, 11), 
+                              sse2_div255(_mm_mullo_epi16(_mm_srli_epi16(d, 11), inv)));
+    __m128i g = _mm_add_epi16(_mm_and_si128(_mm_srli_epi16(s, 5), mask6), 
+                              sse2_div255(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(d, 5), mask6), inv)));
+    __m128i b = _mm_add_epi16(_mm_and_si128(s, mask5), 
+                              sse2_div255(_mm_mullo_epi16(_mm_and_si128(d, mask5), inv)));
+    
+    r = _mm_min_epi16(r, mask5);
+    g = _mm_min_epi16(g, mask6);
+    b = _mm_min_epi16(b, mask5);
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+}
+#endif
+
+/**
+ * 把一段预乘像素叠加到不透明的目标上 (每次8个像素)
+ */
+void fbtft_blit_blend_span(uint16_t *dst, const uint16_t *src, const uint8_t *alpha, int count) {
+    if (!dst || !src || !alpha || count <= 0) return;
+    
+    int i = 0;
+    
+#if defined(FBTFT_BLIT_NEON)
+    const uint8x8_t full = vdup_n_u8(255);
+    for (; i + 8 <= count; i += 8) {
+        uint16x8_t inv = vmovl_u8(vsub_u8(full, vld1_u8(alpha + i)));
+        vst1q_u16(dst + i, neon_blend8(vld1q_u16(dst + i), vld1q_u16(src + i), inv));
+    }
+#elif defined(FBTFT_BLIT_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    for (; i + 8 <= count; i += 8) {
+        __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(alpha + i)), zero);
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dst + i), sse2_blend8(d, s, _mm_sub_epi16(full, a)));
+    }
+#endif
+    
+    for (; i < count; i++) {
+        dst[i] = blend_pixel(dst[i], src[i], 255u - alpha[i]);
+    }
+}
+
+/**
+ * 把一段预乘像素叠加到另一段预乘像素上，目标的alpha同时更新：
+ * da = sa + da * (255 - sa) / 255
+ */
+void fbtft_blit_blend_over_span(uint16_t *dst, uint8_t *dst_alpha, 
+                                const uint16_t *src, const uint8_t *alpha, int count) {
+    if (!dst || !dst_alpha || !src || !alpha || count <= 0) return;
+    
+    int i = 0;
+    
+#if defined(FBTFT_BLIT_NEON)
+    const uint8x8_t full = vdup_n_u8(255);
+    for (; i + 8 <= count; i += 8) {
+        uint8x8_t sa = vld1_u8(alpha + i);
+        uint16x8_t inv = vmovl_u8(vsub_u8(full, sa));
+        uint16x8_t da = neon_div255(vmulq_u16(vmovl_u8(vld1_u8(dst_alpha + i)), inv));
+        vst1_u8(dst_alpha + i, vqmovn_u16(vaddw_u8(da, sa)));
+        vst1q_u16(dst + i, neon_blend8(vld1q_u16(dst + i), vld1q_u16(src + i), inv));
+    }
+#elif defined(FBTFT_BLIT_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    for (; i + 8 <= count; i += 8) {
+        __m128i sa = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(alpha + i)), zero);
+        __m128i inv = _mm_sub_epi16(full, sa);
+        __m128i da = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(dst_alpha + i)), zero);
+        da = _mm_add_epi16(sa, sse2_div255(_mm_mullo_epi16(da, inv)));
+        _mm_storel_epi64((__m128i *)(dst_alpha + i), _mm_packus_epi16(da, zero));
+        
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dst + i), sse2_blend8(d, s, inv));
+    }
+#endif
+    
+    for (; i < count; i++) {
+        uint32_t inv = 255u - alpha[i];
+        uint32_t da = alpha[i] + blend_div255((uint32_t)dst_alpha[i] * inv);
+        dst_alpha[i] = (uint8_t)(da > 255 ? 255 : da);
+        dst[i] = blend_pixel(dst[i], src[i], inv);
+    }
+}
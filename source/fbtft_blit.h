@@ -0,0 +1,62 @@
+#ifndef _FBTFT_BLIT_H_
+#define _FBTFT_BLIT_H_
+
+/*
+ * 库内部使用的像素块复制/填充引擎
+ * 所有行距 (stride) 均以字节为单位，允许源和目标行距不同 (例如带行填充的framebuffer)
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "fbtft_lcd.h"
+
+// 按行复制 width x height 的RGB565像素块
+void fbtft_blit_copy(uint16_t *dst, size_t dst_stride, 
+                     const uint16_t *src, size_t src_stride, 
+                     int width, int height);
+
+// 用单一颜色填充 width x height 的RGB565像素块
+void fbtft_blit_fill(uint16_t *dst, size_t dst_stride, int width, int height, uint16_t color);
+
+// 用单一颜色填充一段连续像素 (NEON / SSE2 / 64位打包写入)
+void fbtft_blit_fill_span(uint16_t *dst, int count, uint16_t color);
+
+// 几何变换操作位，描述源像素 (x, y) 在目标中的位置：
+// 不转置时目标为 src_width x src_height:  x' = FLIP_X ? W-1-x : x,  y' = FLIP_Y ? H-1-y : y
+// 转置时目标为 src_height x src_width:    x' = FLIP_X ? H-1-y : y,  y' = FLIP_Y ? W-1-x : x
+// 任意旋转+镜像组合都可以化简为这8种操作之一
+#define FBTFT_BLIT_FLIP_X       0x1
+#define FBTFT_BLIT_FLIP_Y       0x2
+#define FBTFT_BLIT_TRANSPOSE    0x4
+
+// 把旋转+镜像组合化简为上面的操作位
+int fbtft_blit_transform_ops(rotation_t rotation, mirror_t mirror);
+
+// 单遍完成几何变换 (src 与 dst 不能重叠)
+// 复制/行反转/上下翻转走逐行快速路径，转置类操作按缓存分块处理
+void fbtft_blit_transform(uint16_t *dst, size_t dst_stride, 
+                          const uint16_t *src, size_t src_stride, 
+                          int src_width, int src_height, int ops);
+
+// 预乘alpha混合 (RGB565 + 每像素8位alpha，src 的颜色已乘以alpha)
+// blend:      d = s + d * (255 - a) / 255，目标不透明
+// blend_over: 目标同样是预乘图像，颜色和alpha都按上式叠加
+// NEON / SSE2 每次处理8个像素，结果与标量实现完全相同
+void fbtft_blit_blend_span(uint16_t *dst, const uint16_t *src, const uint8_t *alpha, int count);
+void fbtft_blit_blend_over_span(uint16_t *dst, uint8_t *dst_alpha, 
+                                const uint16_t *src, const uint8_t *alpha, int count);
+
+// 允许与uint16_t像素缓冲区别名访问的宽类型，用于打包读写
+typedef uint32_t __attribute__((may_alias)) fbtft_u32_alias_t;
+typedef uint64_t __attribute__((may_alias)) fbtft_u64_alias_t;
+
+// 按字节偏移取得某一行的起始地址
+static inline uint16_t *fbtft_blit_row(uint16_t *base, size_t stride, int y) {
+    return (uint16_t *)((uint8_t *)base + (size_t)y * stride);
+}
+
+static inline const uint16_t *fbtft_blit_row_const(const uint16_t *base, size_t stride, int y) {
+    return (const uint16_t *)((const uint8_t *)base + (size_t)y * stride);
+}
+
+#endif /* _FBTFT_BLIT_H_ */
@@ -0,0 +1,326 @@
+#include "fbtft_image_cache.h"
+#include "fbtft_blit.h"
+#include "fbtft_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/**
+ * 从链表中摘下一项 (调用者持有lock)
+ */
+static void entry_unlink(fbtft_image_cache_t *cache, fbtft_image_entry_t *entry) {
+    if (entry->prev) entry->prev->next = entry->next;
+    else cache->head = entry->next;
+    if (entry->next) entry->next->prev = entry->prev;
+    else cache->tail = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+
+/**
+ * 插入到链表头部，成为最近使用的一项 (调用者持有lock)
+ */
+static void entry_push_front(fbtft_image_cache_t *cache, fbtft_image_entry_t *entry) {
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if (cache->head) cache->head->prev = entry;
+    cache->head = entry;
+    if (!cache->tail) cache->tail = entry;
+}
+
+/**
+ * 帧数据和表项 (路径跟在表项之后) 都归还到缓冲区池
+ */
+static void entry_free(fbtft_image_entry_t *entry) {
+    fbtft_pool_free(entry->pixels);
+    fbtft_pool_free(entry);
+}
+
+/**
+ * 移除并释放一项 (调用者持有lock)
+ */
+static void entry_remove(fbtft_image_cache_t *cache, fbtft_image_entry_t *entry) {
+    entry_unlink(cache, entry);
+    cache->bytes -= entry->bytes;
+    cache->entries--;
+    entry_free(entry);
+}
+
+/**
+ * 查找与键完全匹配的帧 (调用者持有lock)
+ * 同一路径但修改时间或大小不同的帧说明文件已被修改，顺便移除
+ */
+static fbtft_image_entry_t *entry_find(fbtft_image_cache_t *cache, const char *path,
+                                       const struct stat *st, int width, int height,
+                                       fit_mode_t fit, rotation_t rotation) {
+    fbtft_image_entry_t *entry = cache->head;
+    
+    while (entry) {
+        fbtft_image_entry_t *next = entry->next;
+        
+        if (strcmp(entry->path, path) == 0) {
+            if (entry->file_size != st->st_size ||
+                entry->mtime.tv_sec != st->st_mtim.tv_sec ||
+                entry->mtime.tv_nsec != st->st_mtim.tv_nsec) {
+                entry_remove(cache, entry);
+                cache->evictions++;
+            } else if (entry->width == width && entry->height == height &&
+                       entry->fit == fit && entry->rotation == rotation) {
+                return entry;
+            }
+        }
+        entry = next;
+    }
+    
+    return NULL;
+}
+
+/**
+ * 初始化帧缓存
+ * @param budget_bytes 缓存帧数据可以使用的最大内存
+ * @return 成功返回0，失败返回-1
+ */
+int fbtft_image_cache_init(fbtft_image_cache_t *cache, size_t budget_bytes) {
+    if (!cache) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    memset(cache, 0, sizeof(*cache));
+    if (pthread_mutex_init(&cache->lock, NULL) != 0) {
+        fprintf(stderr, "Error: Failed to initialize image cache lock\n");
+        return -1;
+    }
+    cache->budget = budget_bytes;
+    
+    return 0;
+}
+
+/**
+ * 释放帧缓存
+ */
+void fbtft_image_cache_deinit(fbtft_image_cache_t *cache) {
+    if (!cache) return;
+    
+    fbtft_image_cache_clear(cache);
+    pthread_mutex_destroy(&cache->lock);
+}
+
+/**
+ * 把解码好的帧放入缓存，pixels 的所有权交给缓存
+ * 单帧超过预算或其他线程已经放入了同一帧时直接归还
+ */
+static void cache_insert(fbtft_image_cache_t *cache, const char *path, const struct stat *st,
+                         int width, int height, fit_mode_t fit, rotation_t rotation, uint16_t *pixels) {
+    size_t frame_bytes = (size_t)width * height * sizeof(uint16_t);
+    
+    // 单帧超过预算时不缓存
+    if (frame_bytes > cache->budget) {
+        fbtft_pool_free(pixels);
+        return;
+    }
+    
+    size_t path_len = strlen(path) + 1;
+    fbtft_image_entry_t *entry = (fbtft_image_entry_t *)fbtft_pool_calloc(sizeof(*entry) + path_len);
+    if (!entry) {
+        fbtft_pool_free(pixels);
+        return;
+    }
+    entry->path = (char *)(entry + 1);
+    memcpy(entry->path, path, path_len);
+    entry->mtime = st->st_mtim;
+    entry->file_size = st->st_size;
+    entry->width = width;
+    entry->height = height;
+    entry->fit = fit;
+    entry->rotation = rotation;
+    entry->pixels = pixels;
+    entry->bytes = frame_bytes;
+    
+    pthread_mutex_lock(&cache->lock);
+    
+    // 其他线程可能已经放入了同一帧
+    fbtft_image_entry_t *existing = entry_find(cache, path, st, width, height, fit, rotation);
+    if (existing) {
+        pthread_mutex_unlock(&cache->lock);
+        entry_free(entry);
+        return;
+    }
+    
+    // 从最久未使用的一端淘汰，直到放得下新帧
+    while (cache->tail && cache->bytes + frame_bytes > cache->budget) {
+        entry_remove(cache, cache->tail);
+        cache->evictions++;
+    }
+    entry_push_front(cache, entry);
+    cache->bytes += frame_bytes;
+    cache->entries++;
+    
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/**
+ * 查找帧，命中时更新LRU顺序，dst 不为NULL时把帧复制过去
+ * @return 命中返回1，未命中返回0
+ */
+static int cache_lookup(fbtft_image_cache_t *cache, const char *path, const struct stat *st,
+                        int width, int height, fit_mode_t fit, rotation_t rotation, 
+                        fbtft_surface_t *dst) {
+    // 命中：复制期间持有锁，保证该帧不会被其他线程淘汰
+    pthread_mutex_lock(&cache->lock);
+    fbtft_image_entry_t *entry = entry_find(cache, path, st, width, height, fit, rotation);
+    if (entry) {
+        entry_unlink(cache, entry);
+        entry_push_front(cache, entry);
+        cache->hits++;
+        if (dst) {
+            fbtft_blit_copy(dst->pixels, (size_t)dst->stride * sizeof(uint16_t), 
+                            entry->pixels, (size_t)width * sizeof(uint16_t), width, height);
+        }
+        pthread_mutex_unlock(&cache->lock);
+        return 1;
+    }
+    cache->misses++;
+    pthread_mutex_unlock(&cache->lock);
+    return 0;
+}
+
+/**
+ * 解码、适配并旋转一帧 (锁外执行)，帧内存从缓冲区池中取
+ * @param info 不为NULL时返回源图像信息
+ * @return 成功返回帧数据，失败返回NULL
+ */
+static uint16_t *cache_decode(const char *path, int width, int height, fit_mode_t fit, rotation_t rotation,
+                              BMPInfo *info) {
+    uint16_t *pixels = (uint16_t *)fbtft_pool_alloc((size_t)width * height * sizeof(uint16_t));
+    if (!pixels) {
+        fprintf(stderr, "Error: Failed to allocate cached frame\n");
+        return NULL;
+    }
+    
+    if (bmp_load_fit_rotated(path, pixels, width, height, fit, rotation, info) != 0) {
+        fbtft_pool_free(pixels);
+        return NULL;
+    }
+    return pixels;
+}
+
+/**
+ * 把图像按适配模式写满 dst 表面
+ * 命中时直接从缓存复制；未命中时完整解码、适配、旋转，再按预算放入缓存
+ * @param dst 旋转后的帧 (屏幕尺寸)，内容可以直接提交，不需要再旋转
+ * @param rotation 旋转方向，不同方向的帧分别缓存
+ * @return 成功返回0，失败返回-1 (dst内容不变)
+ */
+int fbtft_image_cache_load(fbtft_image_cache_t *cache, const char *path, fbtft_surface_t *dst,
+                           fit_mode_t fit, rotation_t rotation) {
+    if (!cache || !path || !dst || !dst->pixels || dst->width <= 0 || dst->height <= 0) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        perror("Error: Failed to stat image file");
+        return -1;
+    }
+    
+    int width = dst->width;
+    int height = dst->height;
+    size_t dst_stride_bytes = (size_t)dst->stride * sizeof(uint16_t);
+    size_t frame_stride_bytes = (size_t)width * sizeof(uint16_t);
+    
+    if (cache_lookup(cache, path, &st, width, height, fit, rotation, dst)) {
+        return 0;
+    }
+    
+    // 未命中：在锁外解码和适配 (大图边解码边缩小)
+    // 帧内存从缓冲区池中取，被淘汰的帧归还后由下一次未命中复用
+    uint16_t *pixels = cache_decode(path, width, height, fit, rotation, NULL);
+    if (!pixels) {
+        return -1;
+    }
+    
+    fbtft_blit_copy(dst->pixels, dst_stride_bytes, pixels, frame_stride_bytes, width, height);
+    
+    cache_insert(cache, path, &st, width, height, fit, rotation, pixels);
+    return 0;
+}
+
+/**
+ * 预先解码并缓存一帧，不输出像素 (例如启动时批量导入)
+ * width/height 为旋转后的尺寸，与 fbtft_image_cache_load 的 dst 相同
+ * 已经缓存时只更新LRU顺序
+ * @param info 不为NULL时返回源图像信息：解码时取自同一次映射，命中时只读取文件头
+ * @return 成功返回0，失败返回-1
+ */
+int fbtft_image_cache_preload(fbtft_image_cache_t *cache, const char *path, int width, int height,
+                              fit_mode_t fit, rotation_t rotation, BMPInfo *info) {
+    if (!cache || !path || width <= 0 || height <= 0) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        perror("Error: Failed to stat image file");
+        return -1;
+    }
+    
+    if (cache_lookup(cache, path, &st, width, height, fit, rotation, NULL)) {
+        if (info) {
+            return bmp_get_info(path, &info->width, &info->height, &info->bpp);
+        }
+        return 0;
+    }
+    
+    uint16_t *pixels = cache_decode(path, width, height, fit, rotation, info);
+    if (!pixels) {
+        return -1;
+    }
+    
+    cache_insert(cache, path, &st, width, height, fit, rotation, pixels);
+    return 0;
+}
+
+/**
+ * 释放所有缓存的帧
+ */
+void fbtft_image_cache_clear(fbtft_image_cache_t *cache) {
+    if (!cache) return;
+    
+    pthread_mutex_lock(&cache->lock);
+    while (cache->head) {
+        entry_remove(cache, cache->head);
+    }
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/**
+ * 获取缓存统计
+ */
+void fbtft_image_cache_get_stats(fbtft_image_cache_t *cache, fbtft_image_cache_stats_t *stats) {
+    if (!cache || !stats) return;
+    
+    pthread_mutex_lock(&cache->lock);
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->evictions = cache->evictions;
+    stats->entries = cache->entries;
+    stats->bytes = cache->bytes;
+    stats->budget = cache->budget;
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/**
+ * 清零命中/未命中/淘汰计数
+ */
+void fbtft_image_cache_reset_stats(fbtft_image_cache_t *cache) {
+    if (!cache) return;
+    
+    pthread_mutex_lock(&cache->lock);
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+    pthread_mutex_unlock(&cache->lock);
+}
@@ -0,0 +1,314 @@
+#include "fbtft_ingest.h"
+#include "fbtft_asset.h"
+#include "fbtft_pacer.h"
+#include "fbtft_threadpool.h"
+#include <dirent.h>
+#include <strings.h>
+#include <sys/stat.h>
+
+// 排序用的路径和原始序号 (路径相同时按原始序号，保证排序稳定)
+typedef struct {
+    const char *path;
+    int index;
+} ingest_key_t;
+
+// 一次导入任务
+typedef struct {
+    const fbtft_ingest_config_t *config;
+    fbtft_ingest_item_t *items;
+} ingest_job_t;
+
+static int ingest_key_compare(const void *a, const void *b) {
+    const ingest_key_t *ka = (const ingest_key_t *)a;
+    const ingest_key_t *kb = (const ingest_key_t *)b;
+    int cmp = strcmp(ka->path, kb->path);
+    if (cmp != 0) return cmp;
+    return (ka->index > kb->index) - (ka->index < kb->index);
+}
+
+/**
+ * 生成资源文件路径：asset_dir/<去掉扩展名的文件名>.f565
+ */
+static char *ingest_asset_path(const char *asset_dir, const char *path) {
+    const char *name = strrchr(path, '/');
+    name = name ? name + 1 : path;
+    const char *dot = strrchr(name, '.');
+    int name_len = dot && dot != name ? (int)(dot - name) : (int)strlen(name);
+    
+    size_t dir_len = strlen(asset_dir);
+    const char *sep = (dir_len > 0 && asset_dir[dir_len - 1] == '/') ? "" : "/";
+    size_t size = dir_len + 1 + (size_t)name_len + sizeof(".f565");
+    char *asset_path = (char *)malloc(size);
+    if (asset_path) {
+        snprintf(asset_path, size, "%s%s%.*s.f565", asset_dir, sep, name_len, name);
+    }
+    return asset_path;
+}
+
+/**
+ * 处理一个文件：校验文件头，并按配置解码、适配
+ * 文件只映射一次，图像信息取自解码用的映射；只校验时不读取像素数据
+ */
+static void ingest_item(const fbtft_ingest_config_t *config, fbtft_ingest_item_t *item) {
+    long long start = fbtft_pacer_now_ns();
+    struct stat st;
+    BMPInfo info;
+    
+    memset(&info, 0, sizeof(info));
+    item->status = -1;
+    if (stat(item->path, &st) == 0) {
+        item->file_bytes = (long long)st.st_size;
+    }
+    
+    switch (config->target) {
+    case FBTFT_INGEST_CACHE:
+        item->status = fbtft_image_cache_preload(config->cache, item->path, config->width,
+                                                 config->height, config->fit, config->rotation, &info);
+        break;
+    case FBTFT_INGEST_ASSET:
+        item->asset_path = ingest_asset_path(config->asset_dir, item->path);
+        if (!item->asset_path) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            break;
+        }
+        item->status = fbtft_asset_convert_bmp(item->path, item->asset_path, config->width,
+                                               config->height, config->fit,
+                                               config->rotation, config->mirror, &info);
+        break;
+    default:
+        item->status = bmp_get_info(item->path, &info.width, &info.height, &info.bpp);
+        break;
+    }
+    
+    item->width = info.width;
+    item->height = info.height;
+    item->bpp = info.bpp;
+    item->decode_ns = fbtft_pacer_now_ns() - start;
+}
+
+/**
+ * 处理 [begin, end) 范围内的文件，结果只写入各自的项
+ */
+static void ingest_band(void *ctx, int begin, int end) {
+    const ingest_job_t *job = (const ingest_job_t *)ctx;
+    
+    for (int i = begin; i < end; i++) {
+        ingest_item(job->config, &job->items[i]);
+    }
+}
+
+/**
+ * 检查配置是否满足处理方式的要求
+ */
+static int ingest_check_config(const fbtft_ingest_config_t *config) {
+    if (config->target == FBTFT_INGEST_VALIDATE) {
+        return 0;
+    }
+    if (config->width <= 0 || config->height <= 0 ||
+        (config->target == FBTFT_INGEST_CACHE && !config->cache) ||
+        (config->target == FBTFT_INGEST_ASSET && !config->asset_dir) ||
+        (config->target != FBTFT_INGEST_CACHE && config->target != FBTFT_INGEST_ASSET)) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * 并行导入给定的文件列表
+ * 文件分给共享线程池，每个文件由一个线程独立完成校验、解码和适配，调用线程同时参与处理；
+ * 单个文件内部的像素运算不再嵌套并行
+ * @param result 结果按路径排序，用 fbtft_ingest_free 释放
+ * @return 导入完成返回0 (个别文件失败记录在各自的 status 中)，参数或内存错误返回-1
+ */
+int fbtft_ingest_list(const char *const *paths, int count, const fbtft_ingest_config_t *config,
+                      fbtft_ingest_result_t *result) {
+    if (!result) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    memset(result, 0, sizeof(*result));
+    
+    if ((!paths && count > 0) || count < 0 || !config || ingest_check_config(config) != 0) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    if (count == 0) {
+        return 0;
+    }
+    
+    long long start = fbtft_pacer_now_ns();
+    
+    // 先排序，结果顺序与输入顺序和线程调度无关
+    ingest_key_t *keys = (ingest_key_t *)malloc((size_t)count * sizeof(ingest_key_t));
+    result->items = (fbtft_ingest_item_t *)calloc((size_t)count, sizeof(fbtft_ingest_item_t));
+    if (!keys || !result->items) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(keys);
+        fbtft_ingest_free(result);
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        keys[i].path = paths[i];
+        keys[i].index = i;
+    }
+    qsort(keys, (size_t)count, sizeof(ingest_key_t), ingest_key_compare);
+    
+    result->count = count;
+    for (int i = 0; i < count; i++) {
+        result->items[i].path = strdup(keys[i].path);
+        if (!result->items[i].path) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            free(keys);
+            fbtft_ingest_free(result);
+            return -1;
+        }
+    }
+    free(keys);
+    
+    // 指定了线程数时调整共享线程池，否则沿用线程池当前的设置
+    if (config->workers > 0) {
+        fbtft_threadpool_set_threads(config->workers);
+    }
+    int workers = fbtft_threadpool_get_threads();
+    if (workers > count) workers = count;
+    
+    ingest_job_t job;
+    job.config = config;
+    job.items = result->items;
+    
+    // 每个文件按一个条带领取：按最小并行数据量计每个文件，条带为1个文件且总能分给工作线程
+    fbtft_parallel_rows(count, FBTFT_PARALLEL_MIN_BYTES, ingest_band, &job);
+    result->workers = workers;
+    
+    for (int i = 0; i < count; i++) {
+        const fbtft_ingest_item_t *item = &result->items[i];
+        result->busy_ns += item->decode_ns;
+        if (item->status == 0) {
+            result->succeeded++;
+            result->total_bytes += item->file_bytes;
+            result->total_pixels += (long long)item->width * item->height;
+        } else {
+            result->failed++;
+        }
+    }
+    result->wall_ns = fbtft_pacer_now_ns() - start;
+    return 0;
+}
+
+/**
+ * 并行导入目录中所有 .bmp 文件
+ * @return 导入完成返回0 (目录中没有BMP文件时 count 为0)，无法打开目录或内存错误返回-1
+ */
+int fbtft_ingest_dir(const char *dir, const fbtft_ingest_config_t *config, fbtft_ingest_result_t *result) {
+    if (!dir || !config || !result) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    memset(result, 0, sizeof(*result));
+    
+    DIR *d = opendir(dir);
+    if (!d) {
+        fprintf(stderr, "Error: Cannot open directory %s\n", dir);
+        return -1;
+    }
+    
+    size_t dir_len = strlen(dir);
+    const char *sep = (dir_len > 0 && dir[dir_len - 1] == '/') ? "" : "/";
+    char **paths = NULL;
+    int count = 0;
+    int capacity = 0;
+    int ret = 0;
+    struct dirent *entry;
+    
+    while ((entry = readdir(d)) != NULL) {
+        size_t len = strlen(entry->d_name);
+        if (len <= 4 || strcasecmp(&entry->d_name[len - 4], ".bmp") != 0) {
+            continue;
+        }
+        
+        if (count == capacity) {
+            int new_capacity = capacity ? capacity * 2 : 16;
+            char **grown = (char **)realloc(paths, (size_t)new_capacity * sizeof(char *));
+            if (!grown) {
+                ret = -1;
+                break;
+            }
+            paths = grown;
+            capacity = new_capacity;
+        }
+        
+        size_t size = dir_len + 1 + len + 1;
+        paths[count] = (char *)malloc(size);
+        if (!paths[count]) {
+            ret = -1;
+            break;
+        }
+        snprintf(paths[count], size, "%s%s%s", dir, sep, entry->d_name);
+        count++;
+    }
+    closedir(d);
+    
+    if (ret != 0) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+    } else {
+        ret = fbtft_ingest_list((const char *const *)paths, count, config, result);
+    }
+    
+    for (int i = 0; i < count; i++) {
+        free(paths[i]);
+    }
+    free(paths);
+    return ret;
+}
+
+/**
+ * 释放导入结果
+ */
+void fbtft_ingest_free(fbtft_ingest_result_t *result) {
+    if (!result) return;
+    
+    if (result->items) {
+        for (int i = 0; i < result->count; i++) {
+            free(result->items[i].path);
+            free(result->items[i].asset_path);
+        }
+        free(result->items);
+    }
+    memset(result, 0, sizeof(*result));
+}
+
+/**
+ * 打印导入吞吐量
+ * 所有文件耗时之和与总耗时之比即为并行处理的加速比
+ */
+void fbtft_ingest_print_report(const fbtft_ingest_result_t *result, int per_file) {
+    if (!result) return;
+    
+    printf("=== Image Ingest ===\n");
+    if (per_file) {
+        for (int i = 0; i < result->count; i++) {
+            const fbtft_ingest_item_t *item = &result->items[i];
+            double ms = item->decode_ns / 1e6;
+            if (item->status != 0) {
+                printf("  [FAIL] %s (%.2f ms)\n", item->path, ms);
+                continue;
+            }
+            double seconds = item->decode_ns > 0 ? item->decode_ns / 1e9 : 0.0;
+            printf("  [ok]   %s %dx%d %dbpp, %.2f ms, %.1f MB/s, %.1f MP/s\n",
+                   item->path, item->width, item->height, item->bpp, ms,
+                   seconds > 0 ? item->file_bytes / (1024.0 * 1024.0) / seconds : 0.0,
+                   seconds > 0 ? (double)item->width * item->height / 1e6 / seconds : 0.0);
+        }
+    }
+    
+    double wall = result->wall_ns / 1e9;
+    printf("Files: %d (%d ok, %d failed), workers: %d\n",
+           result->count, result->succeeded, result->failed, result->workers);
+    printf("Wall time: %.1f ms, %.1f files/s, %.1f MB/s, %.1f MP/s\n", result->wall_ns / 1e6,
+           wall > 0 ? result->count / wall : 0.0,
+           wall > 0 ? result->total_bytes / (1024.0 * 1024.0) / wall : 0.0,
+           wall > 0 ? result->total_pixels / 1e6 / wall : 0.0);
+    printf("Busy time: %.1f ms (parallel speedup %.2fx)\n", result->busy_ns / 1e6,
+           result->wall_ns > 0 ? (double)result->busy_ns / result->wall_ns : 0.0);
+    printf("====================\n");
+}
@@ -1,4 +1,56 @@
 #include "fbtft_lcd.h"
+#include "fbtft_blit.h"
+#include "fbtft_surface.h"
+#include "fbtft_scaler.h"
+
+/**
+ * 每行的字节数 (驱动未提供line_length时按紧凑排列计算)
+ */
+static size_t fb_line_bytes(const fbtft_lcd_t *lcd) {
+    if (lcd->finfo.line_length) {
+        return lcd->finfo.line_length;
+    }
+    return (size_t)lcd->width * sizeof(uint16_t);
+}
+
+/**
+ * 获取framebuffer中指定页的起始地址
+ */
+static uint16_t *fb_page(const fbtft_lcd_t *lcd, int page) {
+    return (uint16_t *)((uint8_t *)lcd->fb_mem + (size_t)page * lcd->height * fb_line_bytes(lcd));
+}
+
+/**
+ * 获取当前显示页的起始地址
+ */
+static uint16_t *fb_front(const fbtft_lcd_t *lcd) {
+    return fb_page(lcd, lcd->front_buffer);
+}
+
+/**
+ * 获取当前显示页中第y行的起始地址
+ */
+static uint16_t *fb_front_row(const fbtft_lcd_t *lcd, int y) {
+    return fbtft_blit_row(fb_front(lcd), fb_line_bytes(lcd), y);
+}
+
+/**
+ * 把一整帧复制到当前显示页并更新统计
+ * @param src_stride 源缓冲区的行距 (字节)
+ */
+static void present_full_frame(fbtft_lcd_t *lcd, const uint16_t *src, size_t src_stride) {
+    size_t pixel_count = (size_t)lcd->width * lcd->height;
+    
+    fbtft_blit_copy(fb_front(lcd), fb_line_bytes(lcd), src, src_stride, lcd->width, lcd->height);
+    
+    // 整帧提交也计入统计，便于和脏区域刷新对比
+    lcd->damage_stats.frames++;
+    lcd->damage_stats.full_frames++;
+    lcd->damage_stats.rects++;
+    lcd->damage_stats.pixels += pixel_count;
+    lcd->damage_stats.last_rects = 1;
+    lcd->damage_stats.last_pixels = (unsigned int)pixel_count;
+}
 
 /**
  * 初始化FBTFT LCD设备
@@ -42,6 +94,24 @@ int fbtft_lcd_init(fbtft_lcd_t *lcd, const char *device_path) {
     // 计算framebuffer大小
     lcd->fb_size = lcd->finfo.smem_len;
     
+    // 清零脏区域统计
+    memset(&lcd->damage_stats, 0, sizeof(lcd->damage_stats));
+    
+    // 默认单缓冲
+    lcd->num_buffers = 1;
+    lcd->front_buffer = 0;
+    lcd->back_buffer = 0;
+    lcd->page_flip = 0;
+    lcd->shadow_buffer = NULL;
+    
+    // 显示已被平移到其他页时 (例如上一个程序留下的状态)，直接绘制到正在显示的页
+    if (lcd->height > 0 && lcd->vinfo.yoffset % lcd->height == 0 &&
+        lcd->vinfo.yoffset + lcd->vinfo.yres <= lcd->vinfo.yres_virtual &&
+        (size_t)(lcd->vinfo.yoffset + lcd->vinfo.yres) * fb_line_bytes(lcd) <= lcd->fb_size) {
+        lcd->front_buffer = lcd->vinfo.yoffset / lcd->height;
+        lcd->back_buffer = lcd->front_buffer;
+    }
+    
     // 内存映射framebuffer
     lcd->fb_mem = (uint16_t *)mmap(0, lcd->fb_size, PROT_READ | PROT_WRITE, 
                                    MAP_SHARED, lcd->fb_fd, 0);
@@ -66,6 +136,17 @@ int fbtft_lcd_init(fbtft_lcd_t *lcd, const char *device_path) {
 void fbtft_lcd_deinit(fbtft_lcd_t *lcd) {
     if (!lcd) return;
     
+    // 翻页模式下恢复显示第0页
+    if (lcd->page_flip && lcd->front_buffer != 0 && lcd->fb_fd >= 0) {
+        lcd->vinfo.yoffset = 0;
+        ioctl(lcd->fb_fd, FBIOPAN_DISPLAY, &lcd->vinfo);
+    }
+    
+    if (lcd->shadow_buffer) {
+        free(lcd->shadow_buffer);
+        lcd->shadow_buffer = NULL;
+    }
+    
     if (lcd->fb_mem != MAP_FAILED && lcd->fb_mem != NULL) {
         munmap(lcd->fb_mem, lcd->fb_size);
         lcd->fb_mem = NULL;
@@ -88,10 +169,7 @@ int fbtft_lcd_clear(fbtft_lcd_t *lcd, uint16_t color) {
         return -1;
     }
     
-    size_t pixel_count = lcd->width * lcd->height;
-    for (size_t i = 0; i < pixel_count; i++) {
-        lcd->fb_mem[i] = color;
-    }
+    fbtft_blit_fill(fb_front(lcd), fb_line_bytes(lcd), lcd->width, lcd->height, color);
     
     return 0;
 }
@@ -105,8 +183,401 @@ int fbtft_lcd_display_buffer(fbtft_lcd_t *lcd, const uint16_t *buffer) {
         return -1;
     }
     
-    size_t pixel_count = lcd->width * lcd->height;
-    memcpy(lcd->fb_mem, buffer, pixel_count * sizeof(uint16_t));
+    present_full_frame(lcd, buffer, (size_t)lcd->width * sizeof(uint16_t));
+    
+    return 0;
+}
+
+/**
+ * 计算两个矩形的外接矩形
+ */
+static fbtft_rect_t rect_union(const fbtft_rect_t *a, const fbtft_rect_t *b) {
+    fbtft_rect_t r;
+    int x2 = (a->x + a->w > b->x + b->w) ? a->x + a->w : b->x + b->w;
+    int y2 = (a->y + a->h > b->y + b->h) ? a->y + a->h : b->y + b->h;
+    
+    r.x = (a->x < b->x) ? a->x : b->x;
+    r.y = (a->y < b->y) ? a->y : b->y;
+    r.w = x2 - r.x;
+    r.h = y2 - r.y;
+    return r;
+}
+
+/**
+ * 计算合并两个矩形后多出来的像素数 (外接矩形面积 - 两矩形面积之和)
+ * 结果 <= 0 表示两矩形重叠或相邻，合并不会多复制像素
+ */
+static long long rect_merge_cost(const fbtft_rect_t *a, const fbtft_rect_t *b) {
+    fbtft_rect_t u = rect_union(a, b);
+    return (long long)u.w * u.h - (long long)a->w * a->h - (long long)b->w * b->h;
+}
+
+/**
+ * 把矩形裁剪到屏幕范围内，完全在屏幕外返回0
+ */
+static int rect_clip(fbtft_rect_t *r, int width, int height) {
+    int x2 = r->x + r->w;
+    int y2 = r->y + r->h;
+    
+    if (r->x < 0) r->x = 0;
+    if (r->y < 0) r->y = 0;
+    if (x2 > width) x2 = width;
+    if (y2 > height) y2 = height;
+    
+    r->w = x2 - r->x;
+    r->h = y2 - r->y;
+    return (r->w > 0 && r->h > 0);
+}
+
+/**
+ * 反复合并列表中合并代价不为正的矩形对，直到没有可合并的矩形
+ */
+static int damage_coalesce(fbtft_rect_t *rects, int count) {
+    int merged = 1;
+    
+    while (merged) {
+        merged = 0;
+        for (int i = 0; i < count && !merged; i++) {
+            for (int j = i + 1; j < count; j++) {
+                if (rect_merge_cost(&rects[i], &rects[j]) <= 0) {
+                    rects[i] = rect_union(&rects[i], &rects[j]);
+                    rects[j] = rects[count - 1];
+                    count--;
+                    merged = 1;
+                    break;
+                }
+            }
+        }
+    }
+    
+    return count;
+}
+
+/**
+ * 清空脏区域列表
+ */
+void fbtft_damage_reset(fbtft_damage_t *damage) {
+    if (!damage) return;
+    damage->count = 0;
+}
+
+/**
+ * 添加一个脏矩形，与重叠或相邻的矩形自动合并
+ * 列表已满时与合并代价最小的矩形合并
+ * @return 成功返回当前矩形数，失败返回-1
+ */
+int fbtft_damage_add(fbtft_damage_t *damage, int x, int y, int w, int h) {
+    if (!damage) return -1;
+    
+    // 空矩形不产生脏区域
+    if (w <= 0 || h <= 0) return damage->count;
+    
+    fbtft_rect_t r = { x, y, w, h };
+    
+    if (damage->count < FBTFT_MAX_DAMAGE_RECTS) {
+        damage->rects[damage->count++] = r;
+    } else {
+        int best = 0;
+        long long best_cost = rect_merge_cost(&damage->rects[0], &r);
+        for (int i = 1; i < damage->count; i++) {
+            long long cost = rect_merge_cost(&damage->rects[i], &r);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best = i;
+            }
+        }
+        damage->rects[best] = rect_union(&damage->rects[best], &r);
+    }
+    
+    damage->count = damage_coalesce(damage->rects, damage->count);
+    return damage->count;
+}
+
+/**
+ * 复制一个已裁剪的矩形到framebuffer
+ */
+static void copy_rect_to_fb(fbtft_lcd_t *lcd, const uint16_t *buffer, size_t stride, 
+                            const fbtft_rect_t *r) {
+    fbtft_blit_copy(fb_front_row(lcd, r->y) + r->x, fb_line_bytes(lcd), 
+                    fbtft_blit_row_const(buffer, stride, r->y) + r->x, stride, 
+                    r->w, r->h);
+}
+
+/**
+ * 只把缓冲区中的一个矩形区域显示到LCD
+ * 缓冲区与屏幕同尺寸，矩形会被裁剪到屏幕范围内
+ */
+int fbtft_lcd_display_region(fbtft_lcd_t *lcd, const uint16_t *buffer, int x, int y, int w, int h) {
+    fbtft_damage_t damage;
+    
+    fbtft_damage_reset(&damage);
+    fbtft_damage_add(&damage, x, y, w, h);
+    return fbtft_lcd_display_damage(lcd, buffer, &damage);
+}
+
+/**
+ * 按脏区域列表把缓冲区显示到LCD
+ * 矩形先裁剪到屏幕范围再合并，只复制这些矩形覆盖的行段
+ * 对于fbtft的deferred I/O，只有被写入的页会重新通过SPI发送
+ */
+int fbtft_lcd_display_damage(fbtft_lcd_t *lcd, const uint16_t *buffer, const fbtft_damage_t *damage) {
+    if (!lcd) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    return fbtft_lcd_display_strided(lcd, buffer, lcd->width, damage);
+}
+
+/**
+ * 显示任意行距的缓冲区到LCD
+ * @param stride 缓冲区每行的像素数 (>= 屏幕宽度)
+ * @param damage 脏区域列表，为NULL时显示整帧
+ */
+int fbtft_lcd_display_strided(fbtft_lcd_t *lcd, const uint16_t *buffer, int stride, 
+                              const fbtft_damage_t *damage) {
+    if (!lcd || !lcd->fb_mem || !buffer || stride < lcd->width) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    size_t stride_bytes = (size_t)stride * sizeof(uint16_t);
+    
+    if (!damage) {
+        present_full_frame(lcd, buffer, stride_bytes);
+        return 0;
+    }
+    
+    fbtft_rect_t rects[FBTFT_MAX_DAMAGE_RECTS];
+    int count = 0;
+    int limit = damage->count < FBTFT_MAX_DAMAGE_RECTS ? damage->count : FBTFT_MAX_DAMAGE_RECTS;
+    
+    for (int i = 0; i < limit; i++) {
+        rects[count] = damage->rects[i];
+        if (rect_clip(&rects[count], lcd->width, lcd->height)) {
+            count++;
+        }
+    }
+    count = damage_coalesce(rects, count);
+    
+    unsigned int pixels = 0;
+    for (int i = 0; i < count; i++) {
+        copy_rect_to_fb(lcd, buffer, stride_bytes, &rects[i]);
+        pixels += (unsigned int)(rects[i].w * rects[i].h);
+    }
+    
+    lcd->damage_stats.frames++;
+    if (pixels == (unsigned int)(lcd->width * lcd->height)) {
+        lcd->damage_stats.full_frames++;
+    }
+    lcd->damage_stats.rects += count;
+    lcd->damage_stats.pixels += pixels;
+    lcd->damage_stats.last_rects = (unsigned int)count;
+    lcd->damage_stats.last_pixels = pixels;
+    
+    return 0;
+}
+
+/**
+ * 获取脏区域刷新统计
+ */
+void fbtft_lcd_get_damage_stats(const fbtft_lcd_t *lcd, fbtft_damage_stats_t *stats) {
+    if (!lcd || !stats) return;
+    *stats = lcd->damage_stats;
+}
+
+/**
+ * 清零脏区域刷新统计
+ */
+void fbtft_lcd_reset_damage_stats(fbtft_lcd_t *lcd) {
+    if (!lcd) return;
+    memset(&lcd->damage_stats, 0, sizeof(lcd->damage_stats));
+}
+
+/**
+ * 进入复制模式：在普通内存中绘制，翻页时复制到显示页
+ */
+static int multibuffer_fallback(fbtft_lcd_t *lcd, int num_buffers) {
+    // 后台缓冲区与framebuffer使用相同的行距，调用者只需关心fbtft_lcd_get_stride()
+    if (!lcd->shadow_buffer) {
+        lcd->shadow_buffer = (uint16_t *)malloc((size_t)lcd->height * fb_line_bytes(lcd));
+        if (!lcd->shadow_buffer) {
+            fprintf(stderr, "Error: Cannot allocate shadow buffer\n");
+            return -1;
+        }
+        memcpy(lcd->shadow_buffer, fb_front(lcd), (size_t)lcd->height * fb_line_bytes(lcd));
+    }
+    
+    lcd->num_buffers = num_buffers;
+    lcd->page_flip = 0;
+    lcd->back_buffer = lcd->front_buffer;
+    
+    printf("Multi-buffering: page flip unavailable, using copy mode\n");
+    return 0;
+}
+
+/**
+ * 启用多缓冲翻页
+ * 请求 yres_virtual = num_buffers * yres，直接在后台页绘制后通过FBIOPAN_DISPLAY切换显示页。
+ * 驱动拒绝虚拟分辨率或显存不足时退回复制模式：后台缓冲区位于普通内存，
+ * fbtft_lcd_flip() 把它复制到显示页。
+ * @param num_buffers 缓冲页数量 (2 = 双缓冲，3 = 三缓冲，1 = 关闭多缓冲)
+ * @return 成功返回0，失败返回-1
+ */
+int fbtft_lcd_enable_multibuffer(fbtft_lcd_t *lcd, int num_buffers) {
+    if (!lcd || !lcd->fb_mem || lcd->fb_fd < 0) {
+        fprintf(stderr, "Error: LCD not initialized\n");
+        return -1;
+    }
+    
+    if (num_buffers < 1 || num_buffers > FBTFT_MAX_BUFFERS) {
+        fprintf(stderr, "Error: Invalid buffer count %d\n", num_buffers);
+        return -1;
+    }
+    
+    // 先回到第0页单缓冲状态
+    if (lcd->front_buffer != 0) {
+        memcpy(fb_page(lcd, 0), fb_front(lcd), (size_t)lcd->height * fb_line_bytes(lcd));
+        lcd->vinfo.xoffset = 0;
+        lcd->vinfo.yoffset = 0;
+        ioctl(lcd->fb_fd, FBIOPAN_DISPLAY, &lcd->vinfo);
+    }
+    lcd->front_buffer = 0;
+    lcd->back_buffer = 0;
+    lcd->page_flip = 0;
+    lcd->num_buffers = 1;
+    if (lcd->shadow_buffer) {
+        free(lcd->shadow_buffer);
+        lcd->shadow_buffer = NULL;
+    }
+    
+    if (num_buffers == 1) {
+        return 0;
+    }
+    
+    size_t page_bytes = (size_t)lcd->height * fb_line_bytes(lcd);
+    
+    // 虚拟分辨率不够时向驱动请求更大的虚拟分辨率
+    if (lcd->vinfo.yres_virtual < (uint32_t)(num_buffers * lcd->height)) {
+        struct fb_var_screeninfo vinfo = lcd->vinfo;
+        vinfo.yres_virtual = num_buffers * lcd->height;
+        vinfo.yoffset = 0;
+        
+        if (ioctl(lcd->fb_fd, FBIOPUT_VSCREENINFO, &vinfo) == -1) {
+            return multibuffer_fallback(lcd, num_buffers);
+        }
+        
+        // 重新读取驱动实际接受的参数
+        if (ioctl(lcd->fb_fd, FBIOGET_VSCREENINFO, &lcd->vinfo) == -1 ||
+            ioctl(lcd->fb_fd, FBIOGET_FSCREENINFO, &lcd->finfo) == -1) {
+            perror("Error reading screen information");
+            return -1;
+        }
+        
+        if (lcd->vinfo.yres_virtual < (uint32_t)(num_buffers * lcd->height)) {
+            return multibuffer_fallback(lcd, num_buffers);
+        }
+        
+        // 显存大小可能随虚拟分辨率改变，需要重新映射
+        if (lcd->finfo.smem_len != lcd->fb_size) {
+            uint16_t *mem = (uint16_t *)mmap(0, lcd->finfo.smem_len, PROT_READ | PROT_WRITE, 
+                                             MAP_SHARED, lcd->fb_fd, 0);
+            if (mem == MAP_FAILED) {
+                perror("Error remapping framebuffer");
+                return multibuffer_fallback(lcd, num_buffers);
+            }
+            munmap(lcd->fb_mem, lcd->fb_size);
+            lcd->fb_mem = mem;
+            lcd->fb_size = lcd->finfo.smem_len;
+        }
+        page_bytes = (size_t)lcd->height * fb_line_bytes(lcd);
+    }
+    
+    if (lcd->fb_size < page_bytes * num_buffers) {
+        return multibuffer_fallback(lcd, num_buffers);
+    }
+    
+    // 确认驱动支持平移显示
+    lcd->vinfo.xoffset = 0;
+    lcd->vinfo.yoffset = 0;
+    if (ioctl(lcd->fb_fd, FBIOPAN_DISPLAY, &lcd->vinfo) == -1) {
+        return multibuffer_fallback(lcd, num_buffers);
+    }
+    
+    lcd->num_buffers = num_buffers;
+    lcd->page_flip = 1;
+    lcd->front_buffer = 0;
+    lcd->back_buffer = 1;
+    
+    printf("Multi-buffering enabled: %d pages, page flip via FBIOPAN_DISPLAY\n", num_buffers);
+    return 0;
+}
+
+/**
+ * 获取当前后台缓冲区 (宽高与屏幕相同，行距见fbtft_lcd_get_stride)
+ * 单缓冲模式下返回显示页本身
+ */
+uint16_t *fbtft_lcd_get_back_buffer(fbtft_lcd_t *lcd) {
+    if (!lcd || !lcd->fb_mem) {
+        return NULL;
+    }
+    
+    if (lcd->shadow_buffer) {
+        return lcd->shadow_buffer;
+    }
+    
+    return fb_page(lcd, lcd->back_buffer);
+}
+
+/**
+ * 获取framebuffer每行的像素数 (包含行尾填充)
+ * 后台缓冲区和显示页都按这个行距排列
+ */
+int fbtft_lcd_get_stride(const fbtft_lcd_t *lcd) {
+    if (!lcd) return 0;
+    return (int)(fb_line_bytes(lcd) / sizeof(uint16_t));
+}
+
+/**
+ * 翻页：显示后台缓冲区的内容
+ * 翻页模式下平移显示到后台页；驱动拒绝平移时退回复制模式
+ * @return 成功返回0，失败返回-1
+ */
+int fbtft_lcd_flip(fbtft_lcd_t *lcd) {
+    if (!lcd || !lcd->fb_mem) {
+        fprintf(stderr, "Error: LCD not initialized\n");
+        return -1;
+    }
+    
+    // 复制模式
+    if (!lcd->page_flip) {
+        if (!lcd->shadow_buffer) {
+            return 0; // 单缓冲，直接绘制在显示页上
+        }
+        present_full_frame(lcd, lcd->shadow_buffer, fb_line_bytes(lcd));
+        return 0;
+    }
+    
+    lcd->vinfo.xoffset = 0;
+    lcd->vinfo.yoffset = lcd->back_buffer * lcd->height;
+    if (ioctl(lcd->fb_fd, FBIOPAN_DISPLAY, &lcd->vinfo) == -1) {
+        // 驱动拒绝平移，把后台页复制到当前显示页，之后改用复制模式
+        uint16_t *back = fb_page(lcd, lcd->back_buffer);
+        lcd->vinfo.yoffset = lcd->front_buffer * lcd->height;
+        if (multibuffer_fallback(lcd, lcd->num_buffers) != 0) {
+            return -1;
+        }
+        memcpy(lcd->shadow_buffer, back, (size_t)lcd->height * fb_line_bytes(lcd));
+        present_full_frame(lcd, lcd->shadow_buffer, fb_line_bytes(lcd));
+        return 0;
+    }
+    
+    lcd->front_buffer = lcd->back_buffer;
+    lcd->back_buffer = (lcd->back_buffer + 1) % lcd->num_buffers;
+    
+    lcd->damage_stats.frames++;
+    lcd->damage_stats.full_frames++;
+    lcd->damage_stats.last_rects = 0;
+    lcd->damage_stats.last_pixels = 0;
     
     return 0;
 }
@@ -124,7 +595,7 @@ int fbtft_lcd_set_pixel(fbtft_lcd_t *lcd, int x, int y, uint16_t color) {
         return -1; // 坐标超出范围
     }
     
-    lcd->fb_mem[y * lcd->width + x] = color;
+    fb_front_row(lcd, y)[x] = color;
     return 0;
 }
 
@@ -140,30 +611,32 @@ uint16_t fbtft_lcd_get_pixel(fbtft_lcd_t *lcd, int x, int y) {
         return 0; // 坐标超出范围
     }
     
-    return lcd->fb_mem[y * lcd->width + x];
+    return fb_front_row(lcd, y)[x];
+}
+
+/**
+ * 把当前显示页包装成绘图表面
+ */
+static void front_surface(fbtft_lcd_t *lcd, fbtft_surface_t *surface) {
+    fbtft_surface_wrap(surface, fb_front(lcd), lcd->width, lcd->height, fbtft_lcd_get_stride(lcd));
 }
 
 /**
  * 绘制矩形边框
  */
 int fbtft_lcd_draw_rectangle(fbtft_lcd_t *lcd, int x1, int y1, int x2, int y2, uint16_t color) {
-    if (!lcd) return -1;
+    if (!lcd || !lcd->fb_mem) {
+        fprintf(stderr, "Error: LCD not initialized\n");
+        return -1;
+    }
     
     // 确保坐标顺序正确
     if (x1 > x2) { int temp = x1; x1 = x2; x2 = temp; }
     if (y1 > y2) { int temp = y1; y1 = y2; y2 = temp; }
     
-    // 绘制水平线
-    for (int x = x1; x <= x2; x++) {
-        fbtft_lcd_set_pixel(lcd, x, y1, color);
-        fbtft_lcd_set_pixel(lcd, x, y2, color);
-    }
-    
-    // 绘制垂直线
-    for (int y = y1; y <= y2; y++) {
-        fbtft_lcd_set_pixel(lcd, x1, y, color);
-        fbtft_lcd_set_pixel(lcd, x2, y, color);
-    }
+    fbtft_surface_t surface;
+    front_surface(lcd, &surface);
+    fbtft_surface_draw_rect(&surface, x1, y1, x2 - x1 + 1, y2 - y1 + 1, color);
     
     return 0;
 }
@@ -172,22 +645,35 @@ int fbtft_lcd_draw_rectangle(fbtft_lcd_t *lcd, int x1, int y1, int x2, int y2, u
  * 填充矩形
  */
 int fbtft_lcd_fill_rectangle(fbtft_lcd_t *lcd, int x1, int y1, int x2, int y2, uint16_t color) {
-    if (!lcd) return -1;
+    if (!lcd || !lcd->fb_mem) {
+        fprintf(stderr, "Error: LCD not initialized\n");
+        return -1;
+    }
     
     // 确保坐标顺序正确
     if (x1 > x2) { int temp = x1; x1 = x2; x2 = temp; }
     if (y1 > y2) { int temp = y1; y1 = y2; y2 = temp; }
     
-    // 边界检查
-    if (x1 < 0) x1 = 0;
-    if (y1 < 0) y1 = 0;
-    if (x2 >= lcd->width) x2 = lcd->width - 1;
-    if (y2 >= lcd->height) y2 = lcd->height - 1;
+    fbtft_surface_t surface;
+    front_surface(lcd, &surface);
+    fbtft_surface_fill_rect(&surface, x1, y1, x2 - x1 + 1, y2 - y1 + 1, color);
     
-    for (int y = y1; y <= y2; y++) {
-        for (int x = x1; x <= x2; x++) {
-            fbtft_lcd_set_pixel(lcd, x, y, color);
-        }
+    return 0;
+}
+
+/**
+ * 批量填充多个矩形 (x, y, w, h)，每个矩形独立裁剪
+ */
+int fbtft_lcd_fill_rectangles(fbtft_lcd_t *lcd, const fbtft_rect_t *rects, int count, uint16_t color) {
+    if (!lcd || !lcd->fb_mem || (!rects && count > 0)) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    fbtft_surface_t surface;
+    front_surface(lcd, &surface);
+    for (int i = 0; i < count; i++) {
+        fbtft_surface_fill_rect(&surface, rects[i].x, rects[i].y, rects[i].w, rects[i].h, color);
     }
     
     return 0;
@@ -367,36 +853,33 @@ int fbtft_lcd_check_device(const char *device_path) {
 
 /**
  * 90度顺时针旋转缓冲区
+ * 目标缓冲区尺寸为 src_height x src_width，内部按缓存分块转置
  */
 void fbtft_lcd_rotate_90(uint16_t *src, uint16_t *dst, int src_width, int src_height) {
-    for (int y = 0; y < src_height; y++) {
-        for (int x = 0; x < src_width; x++) {
-            // (x, y) -> (y, src_width - 1 - x)
-            dst[y * src_width + (src_width - 1 - x)] = src[y * src_width + x];
-        }
-    }
+    // (x, y) -> (y, src_width - 1 - x)
+    fbtft_blit_transform(dst, (size_t)src_height * sizeof(uint16_t), 
+                         src, (size_t)src_width * sizeof(uint16_t), src_width, src_height, 
+                         FBTFT_BLIT_TRANSPOSE | FBTFT_BLIT_FLIP_Y);
 }
 
 /**
  * 270度顺时针旋转缓冲区 (或90度逆时针)
+ * 目标缓冲区尺寸为 src_height x src_width，内部按缓存分块转置
  */
 void fbtft_lcd_rotate_270(uint16_t *src, uint16_t *dst, int src_width, int src_height) {
-    for (int y = 0; y < src_height; y++) {
-        for (int x = 0; x < src_width; x++) {
-            // (x, y) -> (src_height - 1 - y, x)
-            dst[(src_height - 1 - y) * src_height + x] = src[y * src_width + x];
-        }
-    }
+    // (x, y) -> (src_height - 1 - y, x)
+    fbtft_blit_transform(dst, (size_t)src_height * sizeof(uint16_t), 
+                         src, (size_t)src_width * sizeof(uint16_t), src_width, src_height, 
+                         FBTFT_BLIT_TRANSPOSE | FBTFT_BLIT_FLIP_X);
 }
 
 /**
  * 180度旋转缓冲区
  */
 void fbtft_lcd_rotate_180(uint16_t *src, uint16_t *dst, int src_width, int src_height) {
-    int total_pixels = src_width * src_height;
-    for (int i = 0; i < total_pixels; i++) {
-        dst[total_pixels - 1 - i] = src[i];
-    }
+    size_t stride = (size_t)src_width * sizeof(uint16_t);
+    fbtft_blit_transform(dst, stride, src, stride, src_width, src_height, 
+                         FBTFT_BLIT_FLIP_X | FBTFT_BLIT_FLIP_Y);
 }
 
 /**
@@ -435,58 +918,18 @@ void fbtft_lcd_mirror_vertical(uint16_t *buffer, int width, int height) {
 
 /**
  * 综合变换缓冲区（旋转 + 镜像）
+ * 16种组合都在一次内存遍历中完成；src 与 dst 不能是同一缓冲区
  */
 void fbtft_lcd_transform_buffer(uint16_t *src, uint16_t *dst, int width, int height, 
                                rotation_t rotation, mirror_t mirror) {
     if (!src || !dst) return;
     
-    uint16_t *work_buffer = dst;
-    int work_width = width;
-    int work_height = height;
+    int ops = fbtft_blit_transform_ops(rotation, mirror);
+    // 转置后目标行宽为源高度
+    int dst_width = (ops & FBTFT_BLIT_TRANSPOSE) ? height : width;
     
-    // 首先进行旋转
-    switch (rotation) {
-        case ROTATE_0:
-            // 不旋转，直接复制
-            memcpy(dst, src, width * height * sizeof(uint16_t));
-            break;
-            
-        case ROTATE_90:
-            fbtft_lcd_rotate_90(src, dst, width, height);
-            work_width = height;
-            work_height = width;
-            break;
-            
-        case ROTATE_180:
-            fbtft_lcd_rotate_180(src, dst, width, height);
-            break;
-            
-        case ROTATE_270:
-            fbtft_lcd_rotate_270(src, dst, width, height);
-            work_width = height;
-            work_height = width;
-            break;
-    }
-    
-    // 然后进行镜像
-    switch (mirror) {
-        case MIRROR_NONE:
-            // 不镜像
-            break;
-            
-        case MIRROR_HORIZONTAL:
-            fbtft_lcd_mirror_horizontal(work_buffer, work_width, work_height);
-            break;
-            
-        case MIRROR_VERTICAL:
-            fbtft_lcd_mirror_vertical(work_buffer, work_width, work_height);
-            break;
-            
-        case MIRROR_BOTH:
-            fbtft_lcd_mirror_horizontal(work_buffer, work_width, work_height);
-            fbtft_lcd_mirror_vertical(work_buffer, work_width, work_height);
-            break;
-    }
+    fbtft_blit_transform(dst, (size_t)dst_width * sizeof(uint16_t), 
+                         src, (size_t)width * sizeof(uint16_t), width, height, ops);
 }
 
 /**
@@ -500,60 +943,83 @@ int fbtft_lcd_auto_fit_buffer(fbtft_lcd_t *lcd, const uint16_t *src_buffer,
     
     // 如果源缓冲区大小与LCD完全匹配，直接复制
     if (src_width == lcd->width && src_height == lcd->height) {
-        memcpy(lcd->fb_mem, src_buffer, lcd->width * lcd->height * sizeof(uint16_t));
+        fbtft_blit_copy(fb_front(lcd), fb_line_bytes(lcd), src_buffer, 
+                        (size_t)src_width * sizeof(uint16_t), src_width, src_height);
         return 0;
     }
     
     // 如果源缓冲区是横屏(320x240)而LCD是竖屏(240x320)，进行旋转
     if (src_width == lcd->height && src_height == lcd->width) {
-        uint16_t *temp_buffer = (uint16_t *)malloc(lcd->width * lcd->height * sizeof(uint16_t));
-        if (!temp_buffer) return -1;
-        
-        // 90度旋转: 320x240 -> 240x320
-        for (int y = 0; y < src_height; y++) {
-            for (int x = 0; x < src_width; x++) {
-                // (x, y) -> (y, src_width - 1 - x)
-                int new_x = y;
-                int new_y = src_width - 1 - x;
-                if (new_x < lcd->width && new_y < lcd->height) {
-                    temp_buffer[new_y * lcd->width + new_x] = src_buffer[y * src_width + x];
-                }
-            }
-        }
-        
-        memcpy(lcd->fb_mem, temp_buffer, lcd->width * lcd->height * sizeof(uint16_t));
-        free(temp_buffer);
+        // 90度旋转: 320x240 -> 240x320，直接写入帧缓冲
+        fbtft_blit_transform(fb_front(lcd), fb_line_bytes(lcd), src_buffer, 
+                             (size_t)src_width * sizeof(uint16_t), src_width, src_height, 
+                             FBTFT_BLIT_TRANSPOSE | FBTFT_BLIT_FLIP_Y);
         return 0;
     }
     
-    // 简单缩放复制 (中心对齐)
-    float scale_x = (float)lcd->width / src_width;
-    float scale_y = (float)lcd->height / src_height;
-    float scale = (scale_x < scale_y) ? scale_x : scale_y;
+    // 保持宽高比缩放并居中，只清除图像以外的边框
+    return fbtft_scale_rgb565(src_buffer, src_width, src_height, src_width, 
+                              fb_front(lcd), lcd->width, lcd->height, 
+                              (int)(fb_line_bytes(lcd) / sizeof(uint16_t)), 
+                              SCALE_NEAREST, SCALE_LETTERBOX, FBTFT_BLACK);
+}
+
+/**
+ * 旋转/镜像后直接提交到framebuffer
+ * 脏矩形先在源坐标系中裁剪，再映射到屏幕坐标，只变换该矩形覆盖的像素
+ */
+int fbtft_lcd_present_transformed(fbtft_lcd_t *lcd, const uint16_t *buffer, 
+                                  int width, int height, int stride, 
+                                  rotation_t rotation, mirror_t mirror, 
+                                  const fbtft_rect_t *damage) {
+    if (!lcd || !lcd->fb_mem || !buffer || width <= 0 || height <= 0 || stride < width) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
     
-    int new_width = (int)(src_width * scale);
-    int new_height = (int)(src_height * scale);
-    int offset_x = (lcd->width - new_width) / 2;
-    int offset_y = (lcd->height - new_height) / 2;
+    int ops = fbtft_blit_transform_ops(rotation, mirror);
+    int transposed = (ops & FBTFT_BLIT_TRANSPOSE) != 0;
+    int out_width = transposed ? height : width;
+    int out_height = transposed ? width : height;
     
-    // 清屏
-    fbtft_lcd_clear(lcd, FBTFT_BLACK);
+    if (out_width != lcd->width || out_height != lcd->height) {
+        fprintf(stderr, "Error: Transformed size %dx%d does not match LCD %dx%d\n", 
+                out_width, out_height, lcd->width, lcd->height);
+        return -1;
+    }
     
-    // 缩放复制
-    for (int y = 0; y < new_height; y++) {
-        for (int x = 0; x < new_width; x++) {
-            int src_x = (int)(x / scale);
-            int src_y = (int)(y / scale);
-            
-            if (src_x < src_width && src_y < src_height) {
-                int dst_x = x + offset_x;
-                int dst_y = y + offset_y;
-                if (dst_x >= 0 && dst_x < lcd->width && dst_y >= 0 && dst_y < lcd->height) {
-                    lcd->fb_mem[dst_y * lcd->width + dst_x] = src_buffer[src_y * src_width + src_x];
-                }
-            }
+    fbtft_rect_t r = {0, 0, width, height};
+    if (damage) {
+        r = *damage;
+        if (!rect_clip(&r, width, height)) {
+            return 0; // 脏矩形完全在源图像之外
         }
     }
     
+    // 矩形左上角在屏幕上的位置：翻转的轴从另一端开始计算
+    int dst_x, dst_y;
+    if (transposed) {
+        dst_x = (ops & FBTFT_BLIT_FLIP_X) ? height - r.y - r.h : r.y;
+        dst_y = (ops & FBTFT_BLIT_FLIP_Y) ? width - r.x - r.w : r.x;
+    } else {
+        dst_x = (ops & FBTFT_BLIT_FLIP_X) ? width - r.x - r.w : r.x;
+        dst_y = (ops & FBTFT_BLIT_FLIP_Y) ? height - r.y - r.h : r.y;
+    }
+    
+    size_t stride_bytes = (size_t)stride * sizeof(uint16_t);
+    fbtft_blit_transform(fb_front_row(lcd, dst_y) + dst_x, fb_line_bytes(lcd), 
+                         fbtft_blit_row_const(buffer, stride_bytes, r.y) + r.x, stride_bytes, 
+                         r.w, r.h, ops);
+    
+    unsigned int pixels = (unsigned int)(r.w * r.h);
+    lcd->damage_stats.frames++;
+    if (pixels == (unsigned int)(lcd->width * lcd->height)) {
+        lcd->damage_stats.full_frames++;
+    }
+    lcd->damage_stats.rects++;
+    lcd->damage_stats.pixels += pixels;
+    lcd->damage_stats.last_rects = 1;
+    lcd->damage_stats.last_pixels = pixels;
+    
     return 0;
 }
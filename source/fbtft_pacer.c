@@ -0,0 +1,186 @@
+#include "fbtft_pacer.h"
+#include <errno.h>
+
+#define NSEC_PER_SEC 1000000000LL
+
+/**
+ * 获取当前单调时钟时间 (纳秒)
+ */
+long long fbtft_pacer_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/**
+ * 以绝对时间睡眠到指定的单调时钟时刻
+ */
+static void sleep_until_ns(long long deadline_ns) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)(deadline_ns / NSEC_PER_SEC);
+    ts.tv_nsec = (long)(deadline_ns % NSEC_PER_SEC);
+    
+    // 被信号打断时继续睡眠到截止时间
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
+/**
+ * 初始化帧调度器
+ * 会探测驱动是否支持FBIO_WAITFORVSYNC (fbtft驱动通常不支持)
+ * @param lcd 可以为NULL，此时只按时钟调度
+ * @param target_fps 目标帧率，例如30或60
+ * @return 成功返回0，失败返回-1
+ */
+int fbtft_pacer_init(fbtft_pacer_t *pacer, fbtft_lcd_t *lcd, double target_fps) {
+    if (!pacer) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    memset(pacer, 0, sizeof(*pacer));
+    pacer->fb_fd = lcd ? lcd->fb_fd : -1;
+    
+    if (fbtft_pacer_set_target(pacer, target_fps) != 0) {
+        return -1;
+    }
+    
+    // 探测垂直同步支持
+    if (pacer->fb_fd >= 0) {
+        uint32_t crtc = 0;
+        if (ioctl(pacer->fb_fd, FBIO_WAITFORVSYNC, &crtc) == 0) {
+            pacer->use_vsync = 1;
+        }
+    }
+    
+    pacer->next_deadline_ns = fbtft_pacer_now_ns() + pacer->interval_ns;
+    
+    printf("Frame pacer: target %.1f FPS, vsync %s\n", 
+           pacer->target_fps, pacer->use_vsync ? "enabled" : "not supported");
+    return 0;
+}
+
+/**
+ * 修改目标帧率，从当前时刻重新开始调度
+ */
+int fbtft_pacer_set_target(fbtft_pacer_t *pacer, double target_fps) {
+    if (!pacer || target_fps <= 0.0) {
+        fprintf(stderr, "Error: Invalid target FPS\n");
+        return -1;
+    }
+    
+    pacer->target_fps = target_fps;
+    pacer->interval_ns = (long long)((double)NSEC_PER_SEC / target_fps);
+    pacer->next_deadline_ns = fbtft_pacer_now_ns() + pacer->interval_ns;
+    return 0;
+}
+
+/**
+ * 等待到下一帧的提交时刻
+ * 在截止时间前睡眠 (而不是忙等)，支持垂直同步时再等待vsync。
+ * 渲染超时时不睡眠并记为错过；落后超过一帧时从当前时刻重新对齐，避免连续补帧。
+ * @return 按时提交返回0，错过截止时间返回1，参数错误返回-1
+ */
+int fbtft_pacer_wait(fbtft_pacer_t *pacer) {
+    if (!pacer || pacer->interval_ns <= 0) {
+        return -1;
+    }
+    
+    long long deadline = pacer->next_deadline_ns;
+    long long now = fbtft_pacer_now_ns();
+    int missed = 0;
+    
+    if (now > deadline) {
+        missed = 1;
+        pacer->missed++;
+    } else {
+        long long wake = deadline;
+        if (pacer->use_vsync) {
+            wake -= FBTFT_PACER_VSYNC_MARGIN_NS;
+        }
+        if (wake > now) {
+            sleep_until_ns(wake);
+        }
+        
+        if (pacer->use_vsync) {
+            uint32_t crtc = 0;
+            if (ioctl(pacer->fb_fd, FBIO_WAITFORVSYNC, &crtc) != 0) {
+                pacer->use_vsync = 0;
+            }
+        }
+        now = fbtft_pacer_now_ns();
+    }
+    
+    // 统计提交时间偏差和实际帧间隔
+    long long jitter = now - deadline;
+    if (jitter < 0) jitter = -jitter;
+    pacer->jitter_sum_ns += jitter;
+    if (jitter > pacer->jitter_max_ns) {
+        pacer->jitter_max_ns = jitter;
+    }
+    if (pacer->frames > 0) {
+        pacer->interval_sum_ns += now - pacer->last_present_ns;
+    }
+    pacer->last_present_ns = now;
+    pacer->frames++;
+    
+    // 计算下一帧的截止时间；使用垂直同步时以实际vsync时刻为基准
+    if (pacer->use_vsync || now - deadline >= pacer->interval_ns) {
+        pacer->next_deadline_ns = now + pacer->interval_ns;
+    } else {
+        pacer->next_deadline_ns = deadline + pacer->interval_ns;
+    }
+    
+    return missed;
+}
+
+/**
+ * 获取帧调度统计
+ */
+void fbtft_pacer_get_stats(const fbtft_pacer_t *pacer, fbtft_pacer_stats_t *stats) {
+    if (!pacer || !stats) return;
+    
+    memset(stats, 0, sizeof(*stats));
+    stats->frames = pacer->frames;
+    stats->missed = pacer->missed;
+    stats->vsync = pacer->use_vsync;
+    stats->max_jitter_us = (double)pacer->jitter_max_ns / 1000.0;
+    
+    if (pacer->frames > 0) {
+        stats->avg_jitter_us = (double)pacer->jitter_sum_ns / pacer->frames / 1000.0;
+    }
+    if (pacer->frames > 1 && pacer->interval_sum_ns > 0) {
+        stats->avg_interval_ms = (double)pacer->interval_sum_ns / (pacer->frames - 1) / 1000000.0;
+        stats->effective_fps = 1000.0 / stats->avg_interval_ms;
+    }
+}
+
+/**
+ * 清零帧调度统计
+ */
+void fbtft_pacer_reset_stats(fbtft_pacer_t *pacer) {
+    if (!pacer) return;
+    
+    pacer->frames = 0;
+    pacer->missed = 0;
+    pacer->jitter_sum_ns = 0;
+    pacer->jitter_max_ns = 0;
+    pacer->interval_sum_ns = 0;
+}
+
+/**
+ * 打印帧调度统计
+ */
+void fbtft_pacer_print_stats(const fbtft_pacer_t *pacer) {
+    fbtft_pacer_stats_t stats;
+    
+    if (!pacer) return;
+    fbtft_pacer_get_stats(pacer, &stats);
+    
+    printf("=== Frame Pacer Statistics ===\n");
+    printf("Target FPS: %.1f (vsync %s)\n", pacer->target_fps, stats.vsync ? "on" : "off");
+    printf("Frames: %llu, Missed deadlines: %llu\n", stats.frames, stats.missed);
+    printf("Effective FPS: %.1f (avg interval %.2f ms)\n", stats.effective_fps, stats.avg_interval_ms);
+    printf("Jitter: avg %.1f us, max %.1f us\n", stats.avg_jitter_us, stats.max_jitter_us);
+    printf("==============================\n");
+}
@@ -0,0 +1,272 @@
+#include "fbtft_playlist.h"
+#include "fbtft_pacer.h"
+#include "fbtft_pool.h"
+
+/**
+ * 解码一张图片到缓冲区 (在解码线程中、锁外执行)
+ */
+static void playlist_decode(fbtft_playlist_t *playlist, fbtft_playlist_frame_t *frame, int index) {
+    const fbtft_playlist_config_t *config = &playlist->config;
+    long long start = fbtft_pacer_now_ns();
+    
+    frame->index = index;
+    if (config->cache) {
+        fbtft_surface_t surface;
+        fbtft_surface_wrap(&surface, frame->pixels, config->width, config->height, config->width);
+        frame->status = fbtft_image_cache_load(config->cache, playlist->paths[index], &surface,
+                                               config->fit, config->rotation);
+    } else {
+        frame->status = bmp_load_fit_rotated(playlist->paths[index], frame->pixels,
+                                             config->width, config->height, config->fit, config->rotation, NULL);
+    }
+    frame->decode_ns = fbtft_pacer_now_ns() - start;
+}
+
+/**
+ * 解码线程：只要有空闲缓冲区就按顺序解码下一张图片
+ */
+static void *playlist_thread(void *arg) {
+    fbtft_playlist_t *playlist = (fbtft_playlist_t *)arg;
+    
+    pthread_mutex_lock(&playlist->lock);
+    while (1) {
+        while (playlist->running && !playlist->finished &&
+               playlist->produced - playlist->released >= (unsigned int)playlist->slot_count) {
+            pthread_cond_wait(&playlist->free_cond, &playlist->lock);
+        }
+        if (!playlist->running || playlist->finished) {
+            break;
+        }
+        
+        // 该缓冲区不在 [released, produced) 范围内，显示线程不会访问
+        fbtft_playlist_frame_t *frame = &playlist->slots[playlist->produce_slot];
+        int index = playlist->next_index;
+        pthread_mutex_unlock(&playlist->lock);
+        
+        playlist_decode(playlist, frame, index);
+        
+        pthread_mutex_lock(&playlist->lock);
+        playlist->produced++;
+        playlist->produce_slot = (playlist->produce_slot + 1) % playlist->slot_count;
+        playlist->decode_ns_sum += frame->decode_ns;
+        if (frame->status != 0) {
+            playlist->failed++;
+        }
+        
+        playlist->next_index = index + 1;
+        if (playlist->next_index >= playlist->count) {
+            if (playlist->config.loop) {
+                playlist->next_index = 0;
+            } else {
+                playlist->finished = 1;
+            }
+        }
+        pthread_cond_signal(&playlist->ready_cond);
+    }
+    pthread_mutex_unlock(&playlist->lock);
+    
+    return NULL;
+}
+
+/**
+ * 释放路径、缓冲区和同步对象
+ */
+static void playlist_cleanup(fbtft_playlist_t *playlist) {
+    for (int i = 0; i < playlist->slot_count; i++) {
+        fbtft_pool_free(playlist->slots[i].pixels);
+        playlist->slots[i].pixels = NULL;
+    }
+    playlist->slot_count = 0;
+    
+    if (playlist->paths) {
+        for (int i = 0; i < playlist->count; i++) {
+            free(playlist->paths[i]);
+        }
+        free(playlist->paths);
+        playlist->paths = NULL;
+    }
+    
+    pthread_mutex_destroy(&playlist->lock);
+    pthread_cond_destroy(&playlist->ready_cond);
+    pthread_cond_destroy(&playlist->free_cond);
+}
+
+/**
+ * 启动播放列表的后台解码线程
+ * 启动后解码线程立即开始预取，显示线程通过 fbtft_playlist_next 按顺序取帧
+ * @param paths 图片路径，启动时复制
+ * @param config 预取深度为0时使用 FBTFT_PLAYLIST_DEFAULT_DEPTH
+ * @return 成功返回0，失败返回-1
+ */
+int fbtft_playlist_start(fbtft_playlist_t *playlist, const char *const *paths, int count,
+                         const fbtft_playlist_config_t *config) {
+    if (!playlist || !paths || count <= 0 || !config || config->width <= 0 || config->height <= 0) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    memset(playlist, 0, sizeof(*playlist));
+    playlist->config = *config;
+    if (playlist->config.depth == 0) {
+        playlist->config.depth = FBTFT_PLAYLIST_DEFAULT_DEPTH;
+    }
+    
+    if (playlist->config.depth < 1 || playlist->config.depth > FBTFT_PLAYLIST_MAX_DEPTH) {
+        fprintf(stderr, "Error: Invalid playlist prefetch depth %d\n", playlist->config.depth);
+        return -1;
+    }
+    
+    pthread_mutex_init(&playlist->lock, NULL);
+    pthread_cond_init(&playlist->ready_cond, NULL);
+    pthread_cond_init(&playlist->free_cond, NULL);
+    
+    playlist->paths = (char **)calloc(count, sizeof(char *));
+    if (!playlist->paths) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        playlist_cleanup(playlist);
+        return -1;
+    }
+    playlist->count = count;
+    for (int i = 0; i < count; i++) {
+        playlist->paths[i] = strdup(paths[i]);
+        if (!playlist->paths[i]) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            playlist_cleanup(playlist);
+            return -1;
+        }
+    }
+    
+    // 预取的帧之外还有一帧正在被显示，缓冲区从缓冲区池中取，重新开始播放时直接复用
+    size_t frame_size = (size_t)config->width * config->height * sizeof(uint16_t);
+    int slot_count = playlist->config.depth + 1;
+    for (int i = 0; i < slot_count; i++) {
+        playlist->slots[i].pixels = (uint16_t *)fbtft_pool_alloc(frame_size);
+        if (!playlist->slots[i].pixels) {
+            fprintf(stderr, "Error: Cannot allocate playlist buffers\n");
+            playlist_cleanup(playlist);
+            return -1;
+        }
+        playlist->slot_count++;
+    }
+    
+    playlist->running = 1;
+    if (pthread_create(&playlist->thread, NULL, playlist_thread, playlist) != 0) {
+        fprintf(stderr, "Error: Cannot create playlist decoder thread\n");
+        playlist->running = 0;
+        playlist_cleanup(playlist);
+        return -1;
+    }
+    
+    printf("Playlist started: %d images, prefetch depth %d\n", count, playlist->config.depth);
+    return 0;
+}
+
+/**
+ * 取出下一帧，同时归还上一次取出的帧
+ * 解码线程还没准备好时阻塞等待，等待时间计入停顿统计
+ * @return 返回的帧在下一次调用 next 或 stop 之前有效；不循环时播放完毕返回NULL
+ */
+const fbtft_playlist_frame_t *fbtft_playlist_next(fbtft_playlist_t *playlist) {
+    if (!playlist || !playlist->running) {
+        return NULL;
+    }
+    
+    pthread_mutex_lock(&playlist->lock);
+    
+    if (playlist->holding) {
+        playlist->released++;
+        playlist->holding = 0;
+        pthread_cond_signal(&playlist->free_cond);
+    }
+    
+    playlist->ready_sum += playlist->produced - playlist->acquired;
+    
+    if (playlist->produced == playlist->acquired) {
+        if (playlist->finished) {
+            pthread_mutex_unlock(&playlist->lock);
+            return NULL;
+        }
+        
+        // 解码线程跟不上显示
+        long long start = fbtft_pacer_now_ns();
+        while (playlist->produced == playlist->acquired) {
+            pthread_cond_wait(&playlist->ready_cond, &playlist->lock);
+        }
+        long long stall = fbtft_pacer_now_ns() - start;
+        
+        playlist->stalls++;
+        playlist->stall_ns_sum += stall;
+        if (stall > playlist->stall_ns_max) {
+            playlist->stall_ns_max = stall;
+        }
+    }
+    
+    fbtft_playlist_frame_t *frame = &playlist->slots[playlist->acquire_slot];
+    playlist->acquire_slot = (playlist->acquire_slot + 1) % playlist->slot_count;
+    playlist->acquired++;
+    playlist->holding = 1;
+    playlist->frames++;
+    
+    pthread_mutex_unlock(&playlist->lock);
+    return frame;
+}
+
+/**
+ * 停止解码线程并释放缓冲区
+ * 正在解码的一帧完成后线程退出，已预取但未取走的帧直接丢弃
+ */
+void fbtft_playlist_stop(fbtft_playlist_t *playlist) {
+    if (!playlist || !playlist->running) return;
+    
+    pthread_mutex_lock(&playlist->lock);
+    playlist->running = 0;
+    pthread_cond_broadcast(&playlist->free_cond);
+    pthread_mutex_unlock(&playlist->lock);
+    pthread_join(playlist->thread, NULL);
+    
+    playlist_cleanup(playlist);
+}
+
+/**
+ * 获取播放列表统计 (停止后仍可获取最终结果)
+ */
+void fbtft_playlist_get_stats(fbtft_playlist_t *playlist, fbtft_playlist_stats_t *stats) {
+    if (!playlist || !stats) return;
+    
+    memset(stats, 0, sizeof(*stats));
+    
+    // 停止后解码线程已退出，锁也已销毁
+    int locked = playlist->running;
+    if (locked) pthread_mutex_lock(&playlist->lock);
+    stats->frames = playlist->frames;
+    stats->failed = playlist->failed;
+    stats->stalls = playlist->stalls;
+    stats->stall_ms_total = playlist->stall_ns_sum / 1000000.0;
+    stats->stall_ms_max = playlist->stall_ns_max / 1000000.0;
+    if (playlist->produced > 0) {
+        stats->avg_decode_ms = (double)playlist->decode_ns_sum / playlist->produced / 1000000.0;
+    }
+    if (playlist->frames > 0) {
+        stats->avg_ready = (double)playlist->ready_sum / playlist->frames;
+    }
+    stats->depth = playlist->config.depth;
+    if (locked) pthread_mutex_unlock(&playlist->lock);
+}
+
+/**
+ * 打印播放列表统计
+ */
+void fbtft_playlist_print_stats(fbtft_playlist_t *playlist) {
+    fbtft_playlist_stats_t stats;
+    
+    if (!playlist) return;
+    fbtft_playlist_get_stats(playlist, &stats);
+    
+    printf("=== Playlist Prefetch Statistics ===\n");
+    printf("Prefetch depth: %d, avg ready frames: %.2f\n", stats.depth, stats.avg_ready);
+    printf("Frames: %llu, Decode failures: %llu, avg decode %.2f ms\n",
+           stats.frames, stats.failed, stats.avg_decode_ms);
+    printf("Stalls: %llu, total %.1f ms, max %.2f ms\n",
+           stats.stalls, stats.stall_ms_total, stats.stall_ms_max);
+    printf("====================================\n");
+}
@@ -0,0 +1,178 @@
+#include "fbtft_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// 每块内存之前的块头，占用一个对齐单位，返回给调用者的地址仍然对齐
+typedef union pool_block {
+    struct {
+        union pool_block *next;         // 空闲链表中的下一块
+        int size_class;                 // 规格 (-1 表示超出最大规格，直接向堆申请)
+        size_t bytes;                   // 可用字节数
+    } h;
+    uint8_t pad[FBTFT_POOL_ALIGN];
+} pool_block_t;
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pool_block_t *free_lists[FBTFT_POOL_CLASSES];
+static size_t idle_limit = FBTFT_POOL_DEFAULT_IDLE;
+static fbtft_pool_stats_t pool_stats;
+
+/**
+ * 规格对应的字节数
+ */
+static size_t class_bytes(int size_class) {
+    size_t base = (size_t)FBTFT_POOL_ALIGN << (size_class / 2);
+    return (size_class & 1) ? base + base / 2 : base;
+}
+
+/**
+ * 找到能放下 bytes 的最小规格，超出最大规格时返回-1
+ */
+static int size_class_of(size_t bytes) {
+    for (int c = 0; c < FBTFT_POOL_CLASSES; c++) {
+        if (bytes <= class_bytes(c)) {
+            return c;
+        }
+    }
+    return -1;
+}
+
+/**
+ * 释放空闲链表中的块，直到空闲内存不超过 limit (调用者持有pool_lock)
+ * 从最大的规格开始释放
+ */
+static void pool_release_idle(size_t limit) {
+    for (int c = FBTFT_POOL_CLASSES - 1; c >= 0 && pool_stats.idle_bytes > limit; c--) {
+        while (free_lists[c] && pool_stats.idle_bytes > limit) {
+            pool_block_t *block = free_lists[c];
+            free_lists[c] = block->h.next;
+            pool_stats.idle_bytes -= block->h.bytes;
+            pool_stats.heap_frees++;
+            free(block);
+        }
+    }
+}
+
+/**
+ * 从池中分配内存
+ * 按规格向上取整，优先复用空闲链表中的块
+ * @return 按 FBTFT_POOL_ALIGN 对齐的内存，失败返回NULL
+ */
+void *fbtft_pool_alloc(size_t bytes) {
+    if (bytes == 0 || bytes > SIZE_MAX - sizeof(pool_block_t)) {
+        return NULL;
+    }
+    
+    int size_class = size_class_of(bytes);
+    size_t size = (size_class >= 0) ? class_bytes(size_class) : bytes;
+    
+    pthread_mutex_lock(&pool_lock);
+    pool_stats.requests++;
+    
+    pool_block_t *block = NULL;
+    if (size_class >= 0 && free_lists[size_class]) {
+        block = free_lists[size_class];
+        free_lists[size_class] = block->h.next;
+        pool_stats.idle_bytes -= size;
+        pool_stats.reuses++;
+    } else {
+        void *mem = NULL;
+        if (posix_memalign(&mem, FBTFT_POOL_ALIGN, sizeof(pool_block_t) + size) != 0) {
+            pthread_mutex_unlock(&pool_lock);
+            fprintf(stderr, "Error: Cannot allocate %zu bytes from buffer pool\n", bytes);
+            return NULL;
+        }
+        block = (pool_block_t *)mem;
+        block->h.size_class = size_class;
+        block->h.bytes = size;
+        pool_stats.heap_allocs++;
+    }
+    
+    block->h.next = NULL;
+    pool_stats.in_use_bytes += size;
+    pthread_mutex_unlock(&pool_lock);
+    
+    return block + 1;
+}
+
+/**
+ * 从池中分配内存并清零
+ */
+void *fbtft_pool_calloc(size_t bytes) {
+    void *ptr = fbtft_pool_alloc(bytes);
+    if (ptr) {
+        memset(ptr, 0, bytes);
+    }
+    return ptr;
+}
+
+/**
+ * 归还内存到池中
+ * 空闲内存超过上限时直接归还给堆
+ */
+void fbtft_pool_free(void *ptr) {
+    if (!ptr) return;
+    
+    pool_block_t *block = (pool_block_t *)ptr - 1;
+    
+    pthread_mutex_lock(&pool_lock);
+    pool_stats.in_use_bytes -= block->h.bytes;
+    
+    if (block->h.size_class < 0 || pool_stats.idle_bytes + block->h.bytes > idle_limit) {
+        pool_stats.heap_frees++;
+        pthread_mutex_unlock(&pool_lock);
+        free(block);
+        return;
+    }
+    
+    block->h.next = free_lists[block->h.size_class];
+    free_lists[block->h.size_class] = block;
+    pool_stats.idle_bytes += block->h.bytes;
+    pthread_mutex_unlock(&pool_lock);
+}
+
+/**
+ * 设置空闲链表最多保留的内存
+ */
+void fbtft_pool_set_idle_limit(size_t bytes) {
+    pthread_mutex_lock(&pool_lock);
+    idle_limit = bytes;
+    pool_release_idle(idle_limit);
+    pthread_mutex_unlock(&pool_lock);
+}
+
+/**
+ * 把空闲链表中的内存全部归还给堆
+ */
+void fbtft_pool_trim(void) {
+    pthread_mutex_lock(&pool_lock);
+    pool_release_idle(0);
+    pthread_mutex_unlock(&pool_lock);
+}
+
+/**
+ * 获取缓冲区池统计
+ */
+void fbtft_pool_get_stats(fbtft_pool_stats_t *stats) {
+    if (!stats) return;
+    
+    pthread_mutex_lock(&pool_lock);
+    *stats = pool_stats;
+    stats->idle_limit = idle_limit;
+    pthread_mutex_unlock(&pool_lock);
+}
+
+/**
+ * 清零请求/复用/堆分配计数 (内存占用不受影响)
+ */
+void fbtft_pool_reset_stats(void) {
+    pthread_mutex_lock(&pool_lock);
+    pool_stats.requests = 0;
+    pool_stats.reuses = 0;
+    pool_stats.heap_allocs = 0;
+    pool_stats.heap_frees = 0;
+    pthread_mutex_unlock(&pool_lock);
+}
@@ -0,0 +1,350 @@
+#include "fbtft_presenter.h"
+
+/**
+ * 初始化无锁队列
+ * 槽数取不小于容量的2的幂，读写计数在2^32处回绕后槽号仍然连续
+ */
+static void queue_init(fbtft_spsc_queue_t *queue, unsigned int capacity) {
+    memset(queue, 0, sizeof(*queue));
+    queue->capacity = capacity;
+    
+    unsigned int slots = 1;
+    while (slots < capacity) {
+        slots <<= 1;
+    }
+    queue->mask = slots - 1;
+}
+
+/**
+ * 入队 (只能由生产者线程调用)
+ * @return 成功返回0，队列满返回-1
+ */
+static int queue_push(fbtft_spsc_queue_t *queue, uint16_t *buffer) {
+    unsigned int head = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+    unsigned int tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+    
+    if (head - tail >= queue->capacity) {
+        return -1;
+    }
+    
+    __atomic_store_n(&queue->slots[head & queue->mask], buffer, __ATOMIC_RELAXED);
+    __atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/**
+ * 出队 (显示线程取帧，PRESENT_LATEST下渲染线程也会取出最旧的帧)
+ * 用CAS推进读取计数，同一帧只会被一方取走
+ * @return 队列为空返回NULL
+ */
+static uint16_t *queue_pop(fbtft_spsc_queue_t *queue) {
+    unsigned int tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+    
+    while (1) {
+        unsigned int head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+        if (head == tail) {
+            return NULL;
+        }
+        
+        uint16_t *buffer = __atomic_load_n(&queue->slots[tail & queue->mask], __ATOMIC_RELAXED);
+        // 失败时 tail 被更新为最新的读取计数，重新读取
+        if (__atomic_compare_exchange_n(&queue->tail, &tail, tail + 1, 0, 
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            return buffer;
+        }
+    }
+}
+
+/**
+ * 队列中的元素数量
+ */
+static unsigned int queue_size(const fbtft_spsc_queue_t *queue) {
+    unsigned int head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+    unsigned int tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+    return head - tail;
+}
+
+/**
+ * 把显示完的缓冲区还给渲染线程
+ */
+static void recycle_buffer(fbtft_presenter_t *presenter, uint16_t *buffer) {
+    queue_push(&presenter->free_queue, buffer);
+    sem_post(&presenter->free_sem);
+}
+
+/**
+ * 显示线程：从队列取出帧并写入framebuffer
+ */
+static void *presenter_thread(void *arg) {
+    fbtft_presenter_t *presenter = (fbtft_presenter_t *)arg;
+    
+    while (1) {
+        sem_wait(&presenter->ready_sem);
+        
+        uint16_t *frame = queue_pop(&presenter->ready_queue);
+        if (!frame) {
+            // 没有帧可取说明是停止信号，或该帧已被渲染线程取回 (PRESENT_LATEST)
+            if (!__atomic_load_n(&presenter->running, __ATOMIC_ACQUIRE)) {
+                break;
+            }
+            continue;
+        }
+        sem_post(&presenter->slot_sem);
+        
+        // 只显示最新的帧，积压的旧帧直接回收
+        if (presenter->config.policy == PRESENT_LATEST) {
+            while (sem_trywait(&presenter->ready_sem) == 0) {
+                uint16_t *newer = queue_pop(&presenter->ready_queue);
+                if (!newer) {
+                    // 取到的是停止信号或已被取回的帧，放回去留给下一轮处理
+                    sem_post(&presenter->ready_sem);
+                    break;
+                }
+                sem_post(&presenter->slot_sem);
+                recycle_buffer(presenter, frame);
+                __atomic_add_fetch(&presenter->dropped_stale, 1, __ATOMIC_RELAXED);
+                frame = newer;
+            }
+        }
+        
+        if (presenter->paced) {
+            fbtft_pacer_wait(&presenter->pacer);
+        }
+        
+        long long start = fbtft_pacer_now_ns();
+        fbtft_lcd_display_buffer(presenter->lcd, frame);
+        if (presenter->config.sync) {
+            fbtft_lcd_sync(presenter->lcd);
+        }
+        long long elapsed = fbtft_pacer_now_ns() - start;
+        
+        __atomic_add_fetch(&presenter->present_ns_sum, (unsigned long long)elapsed, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&presenter->presented, 1, __ATOMIC_RELAXED);
+        
+        recycle_buffer(presenter, frame);
+    }
+    
+    return NULL;
+}
+
+/**
+ * 释放缓冲区和同步对象
+ */
+static void presenter_cleanup(fbtft_presenter_t *presenter) {
+    for (int i = 0; i < presenter->buffer_count; i++) {
+        free(presenter->buffers[i]);
+        presenter->buffers[i] = NULL;
+    }
+    presenter->buffer_count = 0;
+    sem_destroy(&presenter->ready_sem);
+    sem_destroy(&presenter->free_sem);
+    sem_destroy(&presenter->slot_sem);
+}
+
+/**
+ * 启动异步显示线程
+ * 启动后LCD由显示线程独占，渲染线程通过acquire/submit交换缓冲区，
+ * 渲染第N+1帧的同时显示线程把第N帧写入framebuffer。
+ * @param config 为NULL时使用默认配置 (深度2，阻塞策略)
+ * @return 成功返回0，失败返回-1
+ */
+int fbtft_presenter_start(fbtft_presenter_t *presenter, fbtft_lcd_t *lcd, 
+                          const fbtft_presenter_config_t *config) {
+    if (!presenter || !lcd || !lcd->fb_mem) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    memset(presenter, 0, sizeof(*presenter));
+    presenter->lcd = lcd;
+    if (config) {
+        presenter->config = *config;
+    } else {
+        presenter->config.depth = 2;
+        presenter->config.policy = PRESENT_BLOCK;
+    }
+    
+    if (presenter->config.depth < 1 || presenter->config.depth > FBTFT_PRESENTER_MAX_DEPTH) {
+        fprintf(stderr, "Error: Invalid presenter queue depth %d\n", presenter->config.depth);
+        return -1;
+    }
+    
+    // 一个正在渲染、一个正在显示，其余最多 depth 个在队列中排队
+    presenter->buffer_count = 0;
+    size_t frame_size = (size_t)lcd->width * lcd->height * sizeof(uint16_t);
+    int count = presenter->config.depth + 2;
+    
+    queue_init(&presenter->ready_queue, presenter->config.depth);
+    queue_init(&presenter->free_queue, count);
+    sem_init(&presenter->ready_sem, 0, 0);
+    sem_init(&presenter->free_sem, 0, 0);
+    sem_init(&presenter->slot_sem, 0, presenter->config.depth);
+    
+    for (int i = 0; i < count; i++) {
+        void *mem = NULL;
+        if (posix_memalign(&mem, 64, frame_size) != 0) {
+            fprintf(stderr, "Error: Cannot allocate presenter buffers\n");
+            presenter_cleanup(presenter);
+            return -1;
+        }
+        presenter->buffers[i] = (uint16_t *)mem;
+        presenter->buffer_count++;
+        queue_push(&presenter->free_queue, presenter->buffers[i]);
+        sem_post(&presenter->free_sem);
+    }
+    
+    if (presenter->config.target_fps > 0.0) {
+        presenter->paced = (fbtft_pacer_init(&presenter->pacer, lcd, presenter->config.target_fps) == 0);
+    }
+    
+    presenter->running = 1;
+    if (pthread_create(&presenter->thread, NULL, presenter_thread, presenter) != 0) {
+        fprintf(stderr, "Error: Cannot create presenter thread\n");
+        presenter->running = 0;
+        presenter_cleanup(presenter);
+        return -1;
+    }
+    
+    printf("Async presenter started: depth %d, %d buffers\n", presenter->config.depth, count);
+    return 0;
+}
+
+/**
+ * 取回队列中最旧的待显示帧 (PRESENT_LATEST)
+ * 该帧计为丢弃，它占用的队列空位直接留给新帧
+ * @return 队列为空返回NULL
+ */
+static uint16_t *take_oldest(fbtft_presenter_t *presenter) {
+    uint16_t *buffer = queue_pop(&presenter->ready_queue);
+    if (buffer) {
+        __atomic_add_fetch(&presenter->dropped_stale, 1, __ATOMIC_RELAXED);
+    }
+    return buffer;
+}
+
+/**
+ * 获取一个空闲缓冲区用于渲染下一帧 (宽高与屏幕相同)
+ * PRESENT_DROP_NEW 策略下没有空闲缓冲区时返回NULL，该帧计为丢弃；
+ * PRESENT_LATEST 策略下不等待，必要时取回最旧的待显示帧重新使用
+ */
+uint16_t *fbtft_presenter_acquire(fbtft_presenter_t *presenter) {
+    if (!presenter || !presenter->running) {
+        return NULL;
+    }
+    
+    if (presenter->spare_count > 0) {
+        return presenter->spare[--presenter->spare_count];
+    }
+    
+    if (presenter->config.policy == PRESENT_BLOCK) {
+        sem_wait(&presenter->free_sem);
+    } else if (sem_trywait(&presenter->free_sem) != 0) {
+        uint16_t *buffer = NULL;
+        if (presenter->config.policy == PRESENT_LATEST) {
+            buffer = take_oldest(presenter);
+        }
+        if (buffer) {
+            // 空位被腾出，留给下一次提交
+            sem_post(&presenter->slot_sem);
+        } else {
+            __atomic_add_fetch(&presenter->dropped_acquire, 1, __ATOMIC_RELAXED);
+        }
+        return buffer;
+    }
+    
+    return queue_pop(&presenter->free_queue);
+}
+
+/**
+ * 提交渲染完成的帧，由显示线程异步写入framebuffer
+ * 待显示的帧最多为队列深度：PRESENT_BLOCK 等待空位；PRESENT_DROP_NEW 拒绝新帧，
+ * 缓冲区留给下一次acquire；PRESENT_LATEST 用新帧替换最旧的待显示帧
+ * @return 成功返回0，参数错误或新帧被拒绝返回-1
+ */
+int fbtft_presenter_submit(fbtft_presenter_t *presenter, uint16_t *buffer) {
+    if (!presenter || !buffer || !presenter->running) {
+        return -1;
+    }
+    
+    if (presenter->config.policy == PRESENT_BLOCK) {
+        sem_wait(&presenter->slot_sem);
+    } else if (sem_trywait(&presenter->slot_sem) != 0) {
+        if (presenter->config.policy == PRESENT_DROP_NEW) {
+            fbtft_presenter_release(presenter, buffer);
+            __atomic_add_fetch(&presenter->dropped_acquire, 1, __ATOMIC_RELAXED);
+            return -1;
+        }
+        
+        uint16_t *oldest = take_oldest(presenter);
+        if (oldest) {
+            fbtft_presenter_release(presenter, oldest);
+        } else {
+            // 显示线程刚取走了最后一帧，空位马上就会归还
+            sem_wait(&presenter->slot_sem);
+        }
+    }
+    
+    unsigned int occupancy = queue_size(&presenter->ready_queue);
+    presenter->occupancy_sum += occupancy;
+    if (occupancy > presenter->occupancy_max) {
+        presenter->occupancy_max = occupancy;
+    }
+    
+    queue_push(&presenter->ready_queue, buffer);
+    __atomic_add_fetch(&presenter->submitted, 1, __ATOMIC_RELAXED);
+    sem_post(&presenter->ready_sem);
+    return 0;
+}
+
+/**
+ * 归还取出后不打算提交的缓冲区，下一次acquire优先使用
+ */
+void fbtft_presenter_release(fbtft_presenter_t *presenter, uint16_t *buffer) {
+    if (!presenter || !buffer) return;
+    if (presenter->spare_count < presenter->buffer_count) {
+        presenter->spare[presenter->spare_count++] = buffer;
+    }
+}
+
+/**
+ * 停止显示线程
+ * 已提交的帧全部显示完后线程退出，然后释放所有缓冲区；
+ * 渲染线程手中尚未提交或归还的缓冲区也随之失效，停止后不能再访问
+ */
+void fbtft_presenter_stop(fbtft_presenter_t *presenter) {
+    if (!presenter || !presenter->running) return;
+    
+    __atomic_store_n(&presenter->running, 0, __ATOMIC_RELEASE);
+    sem_post(&presenter->ready_sem);
+    pthread_join(presenter->thread, NULL);
+    
+    presenter->spare_count = 0;
+    presenter_cleanup(presenter);
+    
+    printf("Async presenter stopped: %llu presented, %llu dropped\n", 
+           presenter->presented, presenter->dropped_acquire + presenter->dropped_stale);
+}
+
+/**
+ * 获取异步显示统计
+ */
+void fbtft_presenter_get_stats(const fbtft_presenter_t *presenter, fbtft_presenter_stats_t *stats) {
+    if (!presenter || !stats) return;
+    
+    memset(stats, 0, sizeof(*stats));
+    stats->submitted = __atomic_load_n(&presenter->submitted, __ATOMIC_RELAXED);
+    stats->presented = __atomic_load_n(&presenter->presented, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&presenter->dropped_acquire, __ATOMIC_RELAXED) +
+                     __atomic_load_n(&presenter->dropped_stale, __ATOMIC_RELAXED);
+    stats->queue_depth = (unsigned int)presenter->config.depth;
+    stats->queue_occupancy = queue_size(&presenter->ready_queue);
+    stats->queue_max = presenter->occupancy_max;
+    
+    if (stats->submitted > 0) {
+        stats->queue_avg = (double)presenter->occupancy_sum / stats->submitted;
+    }
+    if (stats->presented > 0) {
+        stats->avg_present_ms = (double)__atomic_load_n(&presenter->present_ns_sum, __ATOMIC_RELAXED) / 
+                                stats->presented / 1000000.0;
+    }
+}
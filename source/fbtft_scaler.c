@@ -0,0 +1,1027 @@
+#include "fbtft_scaler.h"
+#include "fbtft_blit.h"
+#include "fbtft_threadpool.h"
+#include "fbtft_pool.h"
+#include <pthread.h>
+
+// 16.16定点数
+#define SCALE_FP_SHIFT      16
+#define SCALE_FP_ONE        (1 << SCALE_FP_SHIFT)
+#define SCALE_FP_HALF       (1 << (SCALE_FP_SHIFT - 1))
+
+// 双线性插值权重的位数 (RGB565每个通道最多6位，5位权重足够)
+#define SCALE_WEIGHT_BITS   5
+#define SCALE_WEIGHT_ONE    (1 << SCALE_WEIGHT_BITS)
+
+// RGB565展开为32位后各通道之间留出空位：G移到高16位，R和B留在低16位
+#define RGB565_SPREAD_MASK  0x07E0F81Fu
+// 每个通道加上半个权重单位，插值结果四舍五入而不是截断
+#define RGB565_SPREAD_ROUND 0x02008010u
+
+static inline uint32_t rgb565_spread(uint16_t c) {
+    return ((uint32_t)c | ((uint32_t)c << 16)) & RGB565_SPREAD_MASK;
+}
+
+static inline uint16_t rgb565_pack(uint32_t v) {
+    return (uint16_t)((v & 0xF81Fu) | ((v >> 16) & 0x07E0u));
+}
+
+// 展开格式下的线性插值，w为 0..SCALE_WEIGHT_ONE
+static inline uint32_t spread_lerp(uint32_t a, uint32_t b, uint32_t w) {
+    return ((a * (SCALE_WEIGHT_ONE - w) + b * w + RGB565_SPREAD_ROUND) >> SCALE_WEIGHT_BITS) & RGB565_SPREAD_MASK;
+}
+
+/**
+ * 源坐标步进 (16.16定点)
+ * 用64位保存，源尺寸达到32768以上时整数部分放不进32位
+ */
+static inline uint64_t scale_step(int src_len, int dst_len) {
+    return ((uint64_t)src_len << SCALE_FP_SHIFT) / (uint64_t)dst_len;
+}
+
+// 一组缩放参数对应的坐标表
+typedef struct {
+    // 缓存键
+    int src_width;
+    int src_height;
+    int dst_width;
+    int dst_height;
+    scale_filter_t filter;
+    scale_policy_t policy;
+    rotation_t rotation;
+    // 适配后的矩形
+    fbtft_rect_t src_rect;
+    fbtft_rect_t dst_rect;
+    // 坐标表 (相对于源矩形左上角)
+    int32_t *x_index;                   // 每个目标列的源x坐标 (区域平均时为dst_w+1个边界)
+    int32_t *y_index;                   // 每个目标行的源y坐标 (区域平均时为dst_h+1个边界)
+    uint8_t *x_weight;                  // 双线性水平权重
+    uint8_t *y_weight;                  // 双线性垂直权重
+    size_t bytes;                       // 坐标表占用的内存
+    // 缓存管理
+    int refs;                           // 正在使用该表的调用数
+    int cached;                         // 是否位于缓存槽中
+    unsigned long long last_used;       // 最近使用时间 (LRU)
+} scale_map_t;
+
+static scale_map_t cache[FBTFT_SCALE_CACHE_ENTRIES];
+static fbtft_scale_cache_stats_t cache_stats;
+static unsigned long long cache_clock;
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * 按适配策略计算源矩形和目标矩形
+ */
+void fbtft_scale_fit(int src_width, int src_height, int dst_width, int dst_height,
+                     scale_policy_t policy, fbtft_rect_t *src_rect, fbtft_rect_t *dst_rect) {
+    fbtft_rect_t s = {0, 0, src_width, src_height};
+    fbtft_rect_t d = {0, 0, dst_width, dst_height};
+    
+    if (src_width > 0 && src_height > 0 && dst_width > 0 && dst_height > 0) {
+        // 比较宽高比时交叉相乘，避免浮点运算
+        long long src_aspect = (long long)src_width * dst_height;
+        long long dst_aspect = (long long)dst_width * src_height;
+        
+        if (policy == SCALE_LETTERBOX) {
+            if (dst_aspect >= src_aspect) {
+                // 目标更宽：高度填满，左右留边
+                d.w = (int)((long long)src_width * dst_height / src_height);
+                if (d.w < 1) d.w = 1;
+                d.x = (dst_width - d.w) / 2;
+            } else {
+                // 目标更高：宽度填满，上下留边
+                d.h = (int)((long long)src_height * dst_width / src_width);
+                if (d.h < 1) d.h = 1;
+                d.y = (dst_height - d.h) / 2;
+            }
+        } else if (policy == SCALE_CROP_FILL) {
+            if (dst_aspect >= src_aspect) {
+                // 目标更宽：源宽度全部使用，裁掉上下
+                s.h = (int)((long long)src_width * dst_height / dst_width);
+                if (s.h < 1) s.h = 1;
+                s.y = (src_height - s.h) / 2;
+            } else {
+                // 目标更高：源高度全部使用，裁掉左右
+                s.w = (int)((long long)src_height * dst_width / dst_height);
+                if (s.w < 1) s.w = 1;
+                s.x = (src_width - s.w) / 2;
+            }
+        }
+    }
+    
+    if (src_rect) *src_rect = s;
+    if (dst_rect) *dst_rect = d;
+}
+
+/**
+ * 双线性坐标：像素中心对齐，返回左侧(上侧)源坐标和权重
+ */
+static inline int bilinear_coord(int64_t pos, int src_len, uint32_t *weight) {
+    if (pos < 0) pos = 0;
+    
+    int i = (int)(pos >> SCALE_FP_SHIFT);
+    if (i >= src_len - 1) {
+        *weight = 0;
+        return src_len - 1;
+    }
+    // 权重四舍五入到 0..SCALE_WEIGHT_ONE
+    *weight = (((uint32_t)pos & (SCALE_FP_ONE - 1)) + (1u << (SCALE_FP_SHIFT - SCALE_WEIGHT_BITS - 1))) 
+              >> (SCALE_FP_SHIFT - SCALE_WEIGHT_BITS);
+    return i;
+}
+
+/**
+ * 计算一个方向上的源坐标表
+ * 最近邻: index[i] 为取样坐标
+ * 双线性: index[i] 为左侧(上侧)坐标，weight[i] 为右侧(下侧)像素的权重
+ * 区域平均: index[0..dst_len] 为各目标像素覆盖范围的边界
+ */
+static void build_axis(int32_t *index, uint8_t *weight, int src_len, int dst_len, 
+                       scale_filter_t filter) {
+    uint64_t step = scale_step(src_len, dst_len);
+    
+    if (filter == SCALE_BILINEAR) {
+        int64_t pos = (int64_t)(step >> 1) - SCALE_FP_HALF;
+        for (int i = 0; i < dst_len; i++, pos += (int64_t)step) {
+            uint32_t w;
+            index[i] = bilinear_coord(pos, src_len, &w);
+            weight[i] = (uint8_t)w;
+        }
+    } else if (filter == SCALE_BOX) {
+        for (int i = 0; i <= dst_len; i++) {
+            index[i] = (int32_t)((long long)i * src_len / dst_len);
+        }
+    } else {
+        uint64_t pos = step >> 1;
+        for (int i = 0; i < dst_len; i++, pos += step) {
+            int v = (int)(pos >> SCALE_FP_SHIFT);
+            index[i] = v < src_len ? v : src_len - 1;
+        }
+    }
+}
+
+/**
+ * 为 src_rect -> dst_rect 分配并计算坐标表 (x、y两个方向共用一块内存)
+ */
+static int scale_map_build(scale_map_t *map, const fbtft_rect_t *src_rect, 
+                           const fbtft_rect_t *dst_rect, scale_filter_t filter) {
+    int dw = dst_rect->w, dh = dst_rect->h;
+    size_t index_bytes = (size_t)(dw + 1 + dh + 1) * sizeof(int32_t);
+    size_t bytes = index_bytes + (size_t)dw + (size_t)dh;
+    
+    uint8_t *block = (uint8_t *)fbtft_pool_alloc(bytes);
+    if (!block) {
+        fprintf(stderr, "Error: Cannot allocate scale tables\n");
+        return -1;
+    }
+    
+    map->src_rect = *src_rect;
+    map->dst_rect = *dst_rect;
+    map->filter = filter;
+    map->x_index = (int32_t *)block;
+    map->y_index = map->x_index + dw + 1;
+    map->x_weight = block + index_bytes;
+    map->y_weight = map->x_weight + dw;
+    map->bytes = bytes;
+    
+    build_axis(map->x_index, map->x_weight, src_rect->w, dw, filter);
+    build_axis(map->y_index, map->y_weight, src_rect->h, dh, filter);
+    return 0;
+}
+
+static void scale_map_free(scale_map_t *map) {
+    fbtft_pool_free(map->x_index);
+    map->x_index = NULL;
+    map->y_index = NULL;
+    map->x_weight = NULL;
+    map->y_weight = NULL;
+    map->bytes = 0;
+}
+
+/**
+ * 最近邻缩放：按坐标表取样
+ */
+static void scale_nearest(const scale_map_t *map, const uint16_t *src, size_t src_stride, 
+                          uint16_t *dst, size_t dst_stride, int y_begin, int y_end) {
+    const int32_t *xi = map->x_index;
+    int dw = map->dst_rect.w;
+    
+    for (int y = y_begin; y < y_end; y++) {
+        const uint16_t *s = fbtft_blit_row_const(src, src_stride, map->y_index[y]);
+        uint16_t *d = fbtft_blit_row(dst, dst_stride, y);
+        
+        for (int x = 0; x < dw; x++) {
+            d[x] = s[xi[x]];
+        }
+    }
+}
+
+/**
+ * 双线性缩放：先在两行内水平插值，再在行间垂直插值
+ */
+static void scale_bilinear(const scale_map_t *map, const uint16_t *src, size_t src_stride, 
+                           uint16_t *dst, size_t dst_stride, int y_begin, int y_end) {
+    const int32_t *xi = map->x_index;
+    const uint8_t *xw = map->x_weight;
+    int dw = map->dst_rect.w;
+    
+    for (int y = y_begin; y < y_end; y++) {
+        uint32_t wy = map->y_weight[y];
+        const uint16_t *s0 = fbtft_blit_row_const(src, src_stride, map->y_index[y]);
+        const uint16_t *s1 = wy ? fbtft_blit_row_const(src, src_stride, map->y_index[y] + 1) : s0;
+        uint16_t *d = fbtft_blit_row(dst, dst_stride, y);
+        
+        for (int x = 0; x < dw; x++) {
+            uint32_t wx = xw[x];
+            int sx = xi[x];
+            int sx1 = wx ? sx + 1 : sx;
+            
+            uint32_t top = spread_lerp(rgb565_spread(s0[sx]), rgb565_spread(s0[sx1]), wx);
+            uint32_t bottom = spread_lerp(rgb565_spread(s1[sx]), rgb565_spread(s1[sx1]), wx);
+            d[x] = rgb565_pack(spread_lerp(top, bottom, wy));
+        }
+    }
+}
+
+/**
+ * 区域平均缩放：每个目标像素取其覆盖的源矩形内所有像素的平均值
+ */
+static void scale_box(const scale_map_t *map, const uint16_t *src, size_t src_stride, 
+                      uint16_t *dst, size_t dst_stride, int y_begin, int y_end) {
+    const int32_t *xi = map->x_index;
+    int dw = map->dst_rect.w;
+    
+    for (int y = y_begin; y < y_end; y++) {
+        int y0 = map->y_index[y];
+        int y1 = map->y_index[y + 1];
+        if (y1 <= y0) y1 = y0 + 1;
+        
+        uint16_t *d = fbtft_blit_row(dst, dst_stride, y);
+        
+        for (int x = 0; x < dw; x++) {
+            int x0 = xi[x];
+            int x1 = xi[x + 1];
+            if (x1 <= x0) x1 = x0 + 1;
+            
+            uint32_t r = 0, g = 0, b = 0;
+            for (int sy = y0; sy < y1; sy++) {
+                const uint16_t *s = fbtft_blit_row_const(src, src_stride, sy);
+                for (int sx = x0; sx < x1; sx++) {
+                    uint16_t c = s[sx];
+                    r += c >> 11;
+                    g += (c >> 5) & 0x3F;
+                    b += c & 0x1F;
+                }
+            }
+            
+            uint32_t n = (uint32_t)((x1 - x0) * (y1 - y0));
+            d[x] = (uint16_t)(((r / n) << 11) | ((g / n) << 5) | (b / n));
+        }
+    }
+}
+
+/**
+ * 按坐标表缩放目标矩形中的 [y_begin, y_end) 行
+ * src 和 dst 分别指向源矩形和目标矩形的左上角
+ */
+static void scale_map_run(const scale_map_t *map, const uint16_t *src, size_t src_stride, 
+                          uint16_t *dst, size_t dst_stride, int y_begin, int y_end) {
+    // 尺寸相同时任何插值方式都等价于复制
+    if (map->src_rect.w == map->dst_rect.w && map->src_rect.h == map->dst_rect.h) {
+        fbtft_blit_copy(fbtft_blit_row(dst, dst_stride, y_begin), dst_stride, 
+                        fbtft_blit_row_const(src, src_stride, y_begin), src_stride, 
+                        map->dst_rect.w, y_end - y_begin);
+        return;
+    }
+    
+    switch (map->filter) {
+        case SCALE_BILINEAR:
+            scale_bilinear(map, src, src_stride, dst, dst_stride, y_begin, y_end);
+            break;
+        case SCALE_BOX:
+            scale_box(map, src, src_stride, dst, dst_stride, y_begin, y_end);
+            break;
+        case SCALE_NEAREST:
+        default:
+            scale_nearest(map, src, src_stride, dst, dst_stride, y_begin, y_end);
+            break;
+    }
+}
+
+// 旋转/镜像后的逻辑源图像在存储中的取样方式：
+// 逻辑像素 (u, v) 位于 origin[u * du + v * dv]，du/dv 为 ±1 或 ±行距 (像素)
+typedef struct {
+    const uint16_t *origin;             // 源矩形左上角 (逻辑坐标) 对应的存储位置
+    ptrdiff_t du;                       // 逻辑x方向的步进
+    ptrdiff_t dv;                       // 逻辑y方向的步进
+} scale_view_t;
+
+/**
+ * 最近邻缩放 (按逻辑坐标在存储中取样)
+ */
+static void scale_nearest_view(const scale_map_t *map, const scale_view_t *view, 
+                               uint16_t *dst, size_t dst_stride, int y_begin, int y_end) {
+    const int32_t *xi = map->x_index;
+    ptrdiff_t du = view->du;
+    int dw = map->dst_rect.w;
+    
+    for (int y = y_begin; y < y_end; y++) {
+        const uint16_t *s = view->origin + map->y_index[y] * view->dv;
+        uint16_t *d = fbtft_blit_row(dst, dst_stride, y);
+        
+        for (int x = 0; x < dw; x++) {
+            d[x] = s[xi[x] * du];
+        }
+    }
+}
+
+/**
+ * 双线性缩放 (按逻辑坐标在存储中取样)，右侧和下侧的相邻像素分别偏移 du 和 dv
+ */
+static void scale_bilinear_view(const scale_map_t *map, const scale_view_t *view, 
+                                uint16_t *dst, size_t dst_stride, int y_begin, int y_end) {
+    const int32_t *xi = map->x_index;
+    const uint8_t *xw = map->x_weight;
+    ptrdiff_t du = view->du;
+    int dw = map->dst_rect.w;
+    
+    for (int y = y_begin; y < y_end; y++) {
+        uint32_t wy = map->y_weight[y];
+        const uint16_t *s0 = view->origin + map->y_index[y] * view->dv;
+        const uint16_t *s1 = wy ? s0 + view->dv : s0;
+        uint16_t *d = fbtft_blit_row(dst, dst_stride, y);
+        
+        for (int x = 0; x < dw; x++) {
+            uint32_t wx = xw[x];
+            ptrdiff_t sx = xi[x] * du;
+            ptrdiff_t sx1 = wx ? sx + du : sx;
+            
+            uint32_t top = spread_lerp(rgb565_spread(s0[sx]), rgb565_spread(s0[sx1]), wx);
+            uint32_t bottom = spread_lerp(rgb565_spread(s1[sx]), rgb565_spread(s1[sx1]), wx);
+            d[x] = rgb565_pack(spread_lerp(top, bottom, wy));
+        }
+    }
+}
+
+/**
+ * 区域平均缩放 (按逻辑坐标在存储中取样)
+ */
+static void scale_box_view(const scale_map_t *map, const scale_view_t *view, 
+                           uint16_t *dst, size_t dst_stride, int y_begin, int y_end) {
+    const int32_t *xi = map->x_index;
+    ptrdiff_t du = view->du;
+    int dw = map->dst_rect.w;
+    
+    for (int y = y_begin; y < y_end; y++) {
+        int y0 = map->y_index[y];
+        int y1 = map->y_index[y + 1];
+        if (y1 <= y0) y1 = y0 + 1;
+        
+        uint16_t *d = fbtft_blit_row(dst, dst_stride, y);
+        
+        for (int x = 0; x < dw; x++) {
+            int x0 = xi[x];
+            int x1 = xi[x + 1];
+            if (x1 <= x0) x1 = x0 + 1;
+            
+            uint32_t r = 0, g = 0, b = 0;
+            for (int sy = y0; sy < y1; sy++) {
+                const uint16_t *s = view->origin + sy * view->dv;
+                for (int sx = x0; sx < x1; sx++) {
+                    uint16_t c = s[sx * du];
+                    r += c >> 11;
+                    g += (c >> 5) & 0x3F;
+                    b += c & 0x1F;
+                }
+            }
+            
+            uint32_t n = (uint32_t)((x1 - x0) * (y1 - y0));
+            d[x] = (uint16_t)(((r / n) << 11) | ((g / n) << 5) | (b / n));
+        }
+    }
+}
+
+// 旋转缩放任务 (按目标行分条带)
+typedef struct {
+    const scale_map_t *map;
+    scale_view_t view;
+    uint16_t *dst;                      // 目标矩形左上角
+    size_t dst_stride;
+} scale_view_job_t;
+
+static void scale_view_band(void *ctx, int begin, int end) {
+    const scale_view_job_t *job = (const scale_view_job_t *)ctx;
+    
+    switch (job->map->filter) {
+        case SCALE_BILINEAR:
+            scale_bilinear_view(job->map, &job->view, job->dst, job->dst_stride, begin, end);
+            break;
+        case SCALE_BOX:
+            scale_box_view(job->map, &job->view, job->dst, job->dst_stride, begin, end);
+            break;
+        case SCALE_NEAREST:
+        default:
+            scale_nearest_view(job->map, &job->view, job->dst, job->dst_stride, begin, end);
+            break;
+    }
+}
+
+// 缩放任务 (按目标行分条带)
+typedef struct {
+    const scale_map_t *map;
+    const uint16_t *src;                // 源矩形左上角
+    size_t src_stride;
+    uint16_t *dst;                      // 目标矩形左上角
+    size_t dst_stride;
+} scale_job_t;
+
+static void scale_band(void *ctx, int begin, int end) {
+    const scale_job_t *job = (const scale_job_t *)ctx;
+    scale_map_run(job->map, job->src, job->src_stride, job->dst, job->dst_stride, begin, end);
+}
+
+/**
+ * 把目标矩形按行条带分给线程池缩放
+ */
+static void scale_map_run_parallel(const scale_map_t *map, const uint16_t *src, size_t src_stride, 
+                                   uint16_t *dst, size_t dst_stride) {
+    scale_job_t job = {map, src, src_stride, dst, dst_stride};
+    fbtft_parallel_rows(map->dst_rect.h, (size_t)map->dst_rect.w * sizeof(uint16_t), scale_band, &job);
+}
+
+/**
+ * 查找或创建坐标表，返回时已增加引用计数
+ * 缓存已满且所有表都在使用中时，返回一个不进入缓存的临时表
+ */
+static scale_map_t *scale_map_acquire(int src_width, int src_height, int dst_width, int dst_height, 
+                                      scale_filter_t filter, scale_policy_t policy, 
+                                      rotation_t rotation) {
+    scale_map_t *map = NULL;
+    scale_map_t *victim = NULL;
+    
+    // 坐标表只与旋转后的源尺寸有关：0/180度共用一组表，90/270度共用一组表
+    rotation = (rotation == ROTATE_90 || rotation == ROTATE_270) ? ROTATE_90 : ROTATE_0;
+    
+    pthread_mutex_lock(&cache_lock);
+    cache_clock++;
+    
+    for (int i = 0; i < FBTFT_SCALE_CACHE_ENTRIES; i++) {
+        scale_map_t *m = &cache[i];
+        if (m->x_index && m->src_width == src_width && m->src_height == src_height && 
+            m->dst_width == dst_width && m->dst_height == dst_height && 
+            m->filter == filter && m->policy == policy && m->rotation == rotation) {
+            map = m;
+            break;
+        }
+        // 优先使用空槽，否则淘汰最久未使用且没有被引用的表
+        if (!m->x_index) {
+            if (!victim || victim->x_index) victim = m;
+        } else if (m->refs == 0 && (!victim || (victim->x_index && m->last_used < victim->last_used))) {
+            victim = m;
+        }
+    }
+    
+    if (map) {
+        cache_stats.hits++;
+        map->refs++;
+        map->last_used = cache_clock;
+        pthread_mutex_unlock(&cache_lock);
+        return map;
+    }
+    
+    cache_stats.misses++;
+    
+    if (victim) {
+        if (victim->x_index) {
+            cache_stats.evictions++;
+            scale_map_free(victim);
+        }
+        map = victim;
+        map->cached = 1;
+    } else {
+        map = (scale_map_t *)calloc(1, sizeof(scale_map_t));
+        if (!map) {
+            pthread_mutex_unlock(&cache_lock);
+            fprintf(stderr, "Error: Cannot allocate scale map\n");
+            return NULL;
+        }
+        map->cached = 0;
+    }
+    
+    // 坐标表按旋转后的源尺寸计算
+    fbtft_rect_t s, d;
+    if (rotation == ROTATE_90) {
+        fbtft_scale_fit(src_height, src_width, dst_width, dst_height, policy, &s, &d);
+    } else {
+        fbtft_scale_fit(src_width, src_height, dst_width, dst_height, policy, &s, &d);
+    }
+    
+    if (scale_map_build(map, &s, &d, filter) != 0) {
+        if (!map->cached) free(map);
+        pthread_mutex_unlock(&cache_lock);
+        return NULL;
+    }
+    
+    map->src_width = src_width;
+    map->src_height = src_height;
+    map->dst_width = dst_width;
+    map->dst_height = dst_height;
+    map->policy = policy;
+    map->rotation = rotation;
+    map->refs = 1;
+    map->last_used = cache_clock;
+    
+    pthread_mutex_unlock(&cache_lock);
+    return map;
+}
+
+static void scale_map_release(scale_map_t *map) {
+    if (!map) return;
+    
+    pthread_mutex_lock(&cache_lock);
+    map->refs--;
+    if (!map->cached) {
+        scale_map_free(map);
+        free(map);
+    }
+    pthread_mutex_unlock(&cache_lock);
+}
+
+/**
+ * 把源图像中的 src_rect 缩放到目标的 dst_rect
+ * 任意矩形的组合不进入缓存，坐标表在调用期间临时计算
+ */
+int fbtft_scale_rect(const uint16_t *src, int src_stride, const fbtft_rect_t *src_rect,
+                     uint16_t *dst, int dst_stride, const fbtft_rect_t *dst_rect,
+                     scale_filter_t filter) {
+    if (!src || !dst || !src_rect || !dst_rect ||
+        src_rect->x < 0 || src_rect->y < 0 || dst_rect->x < 0 || dst_rect->y < 0 ||
+        src_rect->w <= 0 || src_rect->h <= 0 || dst_rect->w <= 0 || dst_rect->h <= 0 ||
+        src_stride < src_rect->x + src_rect->w || dst_stride < dst_rect->x + dst_rect->w) {
+        fprintf(stderr, "Error: Invalid scale parameters\n");
+        return -1;
+    }
+    
+    scale_map_t map;
+    if (scale_map_build(&map, src_rect, dst_rect, filter) != 0) {
+        return -1;
+    }
+    
+    size_t src_stride_bytes = (size_t)src_stride * sizeof(uint16_t);
+    size_t dst_stride_bytes = (size_t)dst_stride * sizeof(uint16_t);
+    scale_map_run_parallel(&map, 
+                           fbtft_blit_row_const(src, src_stride_bytes, src_rect->y) + src_rect->x, src_stride_bytes, 
+                           fbtft_blit_row(dst, dst_stride_bytes, dst_rect->y) + dst_rect->x, dst_stride_bytes);
+    
+    scale_map_free(&map);
+    return 0;
+}
+
+/**
+ * 用背景色填充目标矩形 d 以外的letterbox边框
+ */
+static void fill_letterbox(uint16_t *dst, size_t dst_stride, int dst_width, int dst_height, 
+                           const fbtft_rect_t *d, uint16_t bg_color) {
+    if (d->y > 0) {
+        fbtft_blit_fill(dst, dst_stride, dst_width, d->y, bg_color);
+    }
+    if (d->y + d->h < dst_height) {
+        fbtft_blit_fill(fbtft_blit_row(dst, dst_stride, d->y + d->h), dst_stride,
+                        dst_width, dst_height - d->y - d->h, bg_color);
+    }
+    if (d->x > 0) {
+        fbtft_blit_fill(fbtft_blit_row(dst, dst_stride, d->y), dst_stride,
+                        d->x, d->h, bg_color);
+    }
+    if (d->x + d->w < dst_width) {
+        fbtft_blit_fill(fbtft_blit_row(dst, dst_stride, d->y) + d->x + d->w, dst_stride,
+                        dst_width - d->x - d->w, d->h, bg_color);
+    }
+}
+
+/**
+ * 按适配策略把整幅源图像缩放到目标缓冲区
+ * 坐标表按 (源尺寸, 目标尺寸, 插值方式, 适配策略, 旋转) 缓存，相同尺寸的后续帧直接查表
+ * letterbox时只填充图像以外的上下或左右边框
+ */
+int fbtft_scale_rgb565(const uint16_t *src, int src_width, int src_height, int src_stride,
+                       uint16_t *dst, int dst_width, int dst_height, int dst_stride,
+                       scale_filter_t filter, scale_policy_t policy, uint16_t bg_color) {
+    if (!src || !dst || src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0) {
+        fprintf(stderr, "Error: Invalid scale parameters\n");
+        return -1;
+    }
+    if (src_stride == 0) src_stride = src_width;
+    if (dst_stride == 0) dst_stride = dst_width;
+    if (src_stride < src_width || dst_stride < dst_width) {
+        fprintf(stderr, "Error: Invalid scale parameters\n");
+        return -1;
+    }
+    
+    scale_map_t *map = scale_map_acquire(src_width, src_height, dst_width, dst_height, 
+                                         filter, policy, ROTATE_0);
+    if (!map) {
+        return -1;
+    }
+    
+    const fbtft_rect_t *s = &map->src_rect;
+    const fbtft_rect_t *d = &map->dst_rect;
+    size_t src_stride_bytes = (size_t)src_stride * sizeof(uint16_t);
+    size_t dst_stride_bytes = (size_t)dst_stride * sizeof(uint16_t);
+    
+    fill_letterbox(dst, dst_stride_bytes, dst_width, dst_height, d, bg_color);
+    
+    scale_map_run_parallel(map, 
+                           fbtft_blit_row_const(src, src_stride_bytes, s->y) + s->x, src_stride_bytes, 
+                           fbtft_blit_row(dst, dst_stride_bytes, d->y) + d->x, dst_stride_bytes);
+    
+    scale_map_release(map);
+    return 0;
+}
+
+/**
+ * 缩放的同时完成旋转/镜像，结果与先 fbtft_lcd_transform_buffer 再 fbtft_scale_rgb565 相同
+ * 按旋转后的顺序直接在源图像中取样，不需要中间缓冲区；90/270度时适配按交换后的源宽高计算
+ * 尺寸相同 (不缩放) 时直接按几何变换复制
+ */
+int fbtft_scale_rgb565_transformed(const uint16_t *src, int src_width, int src_height, int src_stride,
+                                   uint16_t *dst, int dst_width, int dst_height, int dst_stride,
+                                   scale_filter_t filter, scale_policy_t policy, uint16_t bg_color,
+                                   rotation_t rotation, mirror_t mirror) {
+    int ops = fbtft_blit_transform_ops(rotation, mirror);
+    if (ops == 0) {
+        return fbtft_scale_rgb565(src, src_width, src_height, src_stride, 
+                                  dst, dst_width, dst_height, dst_stride, filter, policy, bg_color);
+    }
+    
+    if (!src || !dst || src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0) {
+        fprintf(stderr, "Error: Invalid scale parameters\n");
+        return -1;
+    }
+    if (src_stride == 0) src_stride = src_width;
+    if (dst_stride == 0) dst_stride = dst_width;
+    if (src_stride < src_width || dst_stride < dst_width) {
+        fprintf(stderr, "Error: Invalid scale parameters\n");
+        return -1;
+    }
+    
+    int transposed = (ops & FBTFT_BLIT_TRANSPOSE) != 0;
+    scale_map_t *map = scale_map_acquire(src_width, src_height, dst_width, dst_height, 
+                                         filter, policy, transposed ? ROTATE_90 : ROTATE_0);
+    if (!map) {
+        return -1;
+    }
+    
+    const fbtft_rect_t *s = &map->src_rect;
+    const fbtft_rect_t *d = &map->dst_rect;
+    size_t src_stride_bytes = (size_t)src_stride * sizeof(uint16_t);
+    size_t dst_stride_bytes = (size_t)dst_stride * sizeof(uint16_t);
+    uint16_t *dst_origin = fbtft_blit_row(dst, dst_stride_bytes, d->y) + d->x;
+    
+    fill_letterbox(dst, dst_stride_bytes, dst_width, dst_height, d, bg_color);
+    
+    if (s->w == d->w && s->h == d->h) {
+        // 源矩形在存储中的位置：翻转的轴从另一端开始计算
+        int x, y;
+        if (transposed) {
+            x = (ops & FBTFT_BLIT_FLIP_Y) ? src_width - s->y - s->h : s->y;
+            y = (ops & FBTFT_BLIT_FLIP_X) ? src_height - s->x - s->w : s->x;
+        } else {
+            x = (ops & FBTFT_BLIT_FLIP_X) ? src_width - s->x - s->w : s->x;
+            y = (ops & FBTFT_BLIT_FLIP_Y) ? src_height - s->y - s->h : s->y;
+        }
+        fbtft_blit_transform(dst_origin, dst_stride_bytes, 
+                             fbtft_blit_row_const(src, src_stride_bytes, y) + x, src_stride_bytes, 
+                             transposed ? s->h : s->w, transposed ? s->w : s->h, ops);
+        scale_map_release(map);
+        return 0;
+    }
+    
+    // 逻辑坐标轴在存储中的起点和步进
+    ptrdiff_t stride = src_stride;
+    ptrdiff_t u0, du, v0, dv;
+    if (transposed) {
+        u0 = (ops & FBTFT_BLIT_FLIP_X) ? (ptrdiff_t)(src_height - 1) * stride : 0;
+        du = (ops & FBTFT_BLIT_FLIP_X) ? -stride : stride;
+        v0 = (ops & FBTFT_BLIT_FLIP_Y) ? src_width - 1 : 0;
+        dv = (ops & FBTFT_BLIT_FLIP_Y) ? -1 : 1;
+    } else {
+        u0 = (ops & FBTFT_BLIT_FLIP_X) ? src_width - 1 : 0;
+        du = (ops & FBTFT_BLIT_FLIP_X) ? -1 : 1;
+        v0 = (ops & FBTFT_BLIT_FLIP_Y) ? (ptrdiff_t)(src_height - 1) * stride : 0;
+        dv = (ops & FBTFT_BLIT_FLIP_Y) ? -stride : stride;
+    }
+    
+    scale_view_job_t job;
+    job.map = map;
+    job.view.origin = src + u0 + v0 + s->x * du + s->y * dv;
+    job.view.du = du;
+    job.view.dv = dv;
+    job.dst = dst_origin;
+    job.dst_stride = dst_stride_bytes;
+    fbtft_parallel_rows(d->h, (size_t)d->w * sizeof(uint16_t), scale_view_band, &job);
+    
+    scale_map_release(map);
+    return 0;
+}
+
+/**
+ * 预先计算并缓存一组尺寸的坐标表 (例如在进入主循环之前)
+ * rotation 与 fbtft_scale_rgb565_transformed 的参数相同，源尺寸为旋转前的尺寸
+ */
+int fbtft_scale_cache_prewarm(int src_width, int src_height, int dst_width, int dst_height, 
+                              scale_filter_t filter, scale_policy_t policy, rotation_t rotation) {
+    if (src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0) {
+        fprintf(stderr, "Error: Invalid scale parameters\n");
+        return -1;
+    }
+    
+    scale_map_t *map = scale_map_acquire(src_width, src_height, dst_width, dst_height, 
+                                         filter, policy, rotation);
+    if (!map) {
+        return -1;
+    }
+    scale_map_release(map);
+    return 0;
+}
+
+/**
+ * 释放所有未被使用的坐标表
+ */
+void fbtft_scale_cache_evict(void) {
+    pthread_mutex_lock(&cache_lock);
+    for (int i = 0; i < FBTFT_SCALE_CACHE_ENTRIES; i++) {
+        if (cache[i].x_index && cache[i].refs == 0) {
+            scale_map_free(&cache[i]);
+            cache_stats.evictions++;
+        }
+    }
+    pthread_mutex_unlock(&cache_lock);
+}
+
+/**
+ * 获取坐标表缓存统计
+ */
+void fbtft_scale_cache_get_stats(fbtft_scale_cache_stats_t *stats) {
+    if (!stats) return;
+    
+    pthread_mutex_lock(&cache_lock);
+    *stats = cache_stats;
+    stats->entries = 0;
+    stats->bytes = 0;
+    for (int i = 0; i < FBTFT_SCALE_CACHE_ENTRIES; i++) {
+        if (cache[i].x_index) {
+            stats->entries++;
+            stats->bytes += cache[i].bytes;
+        }
+    }
+    pthread_mutex_unlock(&cache_lock);
+}
+
+/**
+ * 清零命中/未命中/淘汰计数
+ */
+void fbtft_scale_cache_reset_stats(void) {
+    pthread_mutex_lock(&cache_lock);
+    memset(&cache_stats, 0, sizeof(cache_stats));
+    pthread_mutex_unlock(&cache_lock);
+}
+
+/**
+ * 初始化流式缩小器，并填充目标中的letterbox边框
+ * 源图像按存储顺序逐行送入：bottom_up 为1时第一行是图像的最下面一行
+ * @return 成功返回0，失败返回-1
+ */
+int fbtft_scale_stream_init(fbtft_scale_stream_t *stream, int src_width, int src_height, int bottom_up,
+                            uint16_t *dst, int dst_width, int dst_height, int dst_stride,
+                            scale_filter_t filter, scale_policy_t policy, uint16_t bg_color) {
+    if (!stream || !dst || src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0) {
+        fprintf(stderr, "Error: Invalid scale parameters\n");
+        return -1;
+    }
+    if (dst_stride == 0) dst_stride = dst_width;
+    if (dst_stride < dst_width) {
+        fprintf(stderr, "Error: Invalid scale parameters\n");
+        return -1;
+    }
+    
+    memset(stream, 0, sizeof(*stream));
+    fbtft_scale_fit(src_width, src_height, dst_width, dst_height, policy, 
+                    &stream->src_rect, &stream->dst_rect);
+    
+    const fbtft_rect_t *s = &stream->src_rect;
+    const fbtft_rect_t *d = &stream->dst_rect;
+    
+    if (filter == SCALE_BOX) {
+        // 区域平均按源行累加，每个源行只属于一个目标行，因此只支持缩小
+        if (s->w < d->w || s->h < d->h) {
+            fprintf(stderr, "Error: Box stream filter only supports downscaling\n");
+            return -1;
+        }
+        // 32位累加器不能溢出
+        uint64_t span = (uint64_t)((s->w + d->w - 1) / d->w) * (uint64_t)((s->h + d->h - 1) / d->h);
+        if (span > UINT32_MAX / 255) {
+            fprintf(stderr, "Error: Scale ratio too large\n");
+            return -1;
+        }
+    }
+    
+    int dw = d->w, dh = d->h;
+    size_t index_bytes = (size_t)(dw + 1 + dh + 1) * sizeof(int32_t);
+    size_t acc_bytes = (filter == SCALE_BOX) ? (size_t)dw * 3 * sizeof(uint32_t) : 0;
+    size_t hrow_bytes = (filter == SCALE_BOX) ? 0 : (size_t)dw * 3 * sizeof(uint16_t);
+    size_t bytes = index_bytes + acc_bytes + 2 * hrow_bytes + (size_t)dw + (size_t)dh + (size_t)s->h;
+    
+    uint8_t *block = (uint8_t *)fbtft_pool_calloc(bytes);
+    if (!block) {
+        fprintf(stderr, "Error: Cannot allocate scale tables\n");
+        return -1;
+    }
+    
+    stream->src_width = src_width;
+    stream->src_height = src_height;
+    stream->bottom_up = bottom_up;
+    stream->filter = filter;
+    stream->dst = dst;
+    stream->dst_stride = (size_t)dst_stride * sizeof(uint16_t);
+    stream->block = block;
+    stream->x_index = (int32_t *)block;
+    stream->y_index = stream->x_index + dw + 1;
+    stream->acc = acc_bytes ? (uint32_t *)(block + index_bytes) : NULL;
+    if (hrow_bytes) {
+        stream->hrows[0] = (uint16_t *)(block + index_bytes);
+        stream->hrows[1] = stream->hrows[0] + (size_t)dw * 3;
+    }
+    stream->x_weight = block + index_bytes + acc_bytes + 2 * hrow_bytes;
+    stream->y_weight = stream->x_weight + dw;
+    stream->row_needed = stream->y_weight + dh;
+    
+    build_axis(stream->x_index, stream->x_weight, s->w, dw, filter);
+    build_axis(stream->y_index, stream->y_weight, s->h, dh, filter);
+    
+    // 标记会被用到的源行，其余的行不需要读取和转换
+    if (filter == SCALE_BOX) {
+        memset(stream->row_needed, 1, (size_t)s->h);
+    } else {
+        for (int j = 0; j < dh; j++) {
+            stream->row_needed[stream->y_index[j]] = 1;
+            if (stream->y_weight[j]) {
+                stream->row_needed[stream->y_index[j] + 1] = 1;
+            }
+        }
+    }
+    
+    stream->next_row = 0;
+    stream->next_dst = bottom_up ? dh - 1 : 0;
+    
+    fill_letterbox(dst, stream->dst_stride, dst_width, dst_height, d, bg_color);
+    return 0;
+}
+
+/**
+ * 下一个送入的行相对于源矩形的行号
+ */
+static int stream_row(const fbtft_scale_stream_t *stream) {
+    int y = stream->bottom_up ? stream->src_height - 1 - stream->next_row : stream->next_row;
+    return y - stream->src_rect.y;
+}
+
+/**
+ * 下一个送入的行是否会被用到 (不需要时调用者可以跳过该行的解码)
+ */
+int fbtft_scale_stream_row_needed(const fbtft_scale_stream_t *stream) {
+    if (!stream || !stream->block || stream->next_row >= stream->src_height) return 0;
+    
+    int y = stream_row(stream);
+    return y >= 0 && y < stream->src_rect.h && stream->row_needed[y];
+}
+
+static inline uint16_t stream_pack(uint32_t b, uint32_t g, uint32_t r) {
+    return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+/**
+ * 双线性/最近邻：水平插值一行，然后输出所有源行都已到齐的目标行
+ */
+static void stream_bilinear_row(fbtft_scale_stream_t *stream, const uint8_t *src, int bpp, int y) {
+    int dw = stream->dst_rect.w;
+    uint16_t *h = stream->hrows[y & 1];
+    
+    for (int x = 0; x < dw; x++) {
+        const uint8_t *a = src + (size_t)stream->x_index[x] * bpp;
+        uint32_t w = stream->x_weight[x];
+        
+        if (w) {
+            const uint8_t *b = a + bpp;
+            h[x * 3 + 0] = (uint16_t)(a[0] * (SCALE_WEIGHT_ONE - w) + b[0] * w);
+            h[x * 3 + 1] = (uint16_t)(a[1] * (SCALE_WEIGHT_ONE - w) + b[1] * w);
+            h[x * 3 + 2] = (uint16_t)(a[2] * (SCALE_WEIGHT_ONE - w) + b[2] * w);
+        } else {
+            h[x * 3 + 0] = (uint16_t)(a[0] << SCALE_WEIGHT_BITS);
+            h[x * 3 + 1] = (uint16_t)(a[1] << SCALE_WEIGHT_BITS);
+            h[x * 3 + 2] = (uint16_t)(a[2] << SCALE_WEIGHT_BITS);
+        }
+    }
+    
+    for (;;) {
+        int j = stream->next_dst;
+        if (j < 0 || j >= stream->dst_rect.h) break;
+        
+        int y0 = stream->y_index[j];
+        uint32_t w = stream->y_weight[j];
+        // 自上而下时等待下侧的行，自下而上时等待上侧的行
+        if (stream->bottom_up ? (y0 < y) : (y0 + (w ? 1 : 0) > y)) break;
+        
+        const uint16_t *h0 = stream->hrows[y0 & 1];
+        const uint16_t *h1 = stream->hrows[(y0 + 1) & 1];
+        uint16_t *d = fbtft_blit_row(stream->dst, stream->dst_stride, stream->dst_rect.y + j) + 
+                      stream->dst_rect.x;
+        const uint32_t round = 1u << (2 * SCALE_WEIGHT_BITS - 1);
+        
+        for (int x = 0; x < dw; x++) {
+            uint32_t c[3];
+            for (int k = 0; k < 3; k++) {
+                uint32_t v = (uint32_t)h0[x * 3 + k] * (SCALE_WEIGHT_ONE - w);
+                if (w) v += (uint32_t)h1[x * 3 + k] * w;
+                c[k] = (v + round) >> (2 * SCALE_WEIGHT_BITS);
+            }
+            d[x] = stream_pack(c[0], c[1], c[2]);
+        }
+        
+        stream->next_dst += stream->bottom_up ? -1 : 1;
+    }
+}
+
+/**
+ * 区域平均：把一行累加到当前目标行，目标行覆盖的源行全部到齐后输出平均值
+ */
+static void stream_box_row(fbtft_scale_stream_t *stream, const uint8_t *src, int bpp, int y) {
+    int dw = stream->dst_rect.w;
+    const int32_t *xi = stream->x_index;
+    uint32_t *acc = stream->acc;
+    
+    for (int x = 0; x < dw; x++) {
+        uint32_t b = 0, g = 0, r = 0;
+        const uint8_t *p = src + (size_t)xi[x] * bpp;
+        for (int sx = xi[x]; sx < xi[x + 1]; sx++, p += bpp) {
+            b += p[0];
+            g += p[1];
+            r += p[2];
+        }
+        acc[x * 3 + 0] += b;
+        acc[x * 3 + 1] += g;
+        acc[x * 3 + 2] += r;
+    }
+    stream->acc_rows++;
+    
+    int j = stream->next_dst;
+    if (j < 0 || j >= stream->dst_rect.h) return;
+    
+    // 自上而下时在范围的最后一行输出，自下而上时在第一行输出
+    int last = stream->bottom_up ? stream->y_index[j] : stream->y_index[j + 1] - 1;
+    if (y != last) return;
+    
+    uint16_t *d = fbtft_blit_row(stream->dst, stream->dst_stride, stream->dst_rect.y + j) + 
+                  stream->dst_rect.x;
+    for (int x = 0; x < dw; x++) {
+        uint32_t n = (uint32_t)(xi[x + 1] - xi[x]) * (uint32_t)stream->acc_rows;
+        d[x] = stream_pack((acc[x * 3 + 0] + n / 2) / n, 
+                           (acc[x * 3 + 1] + n / 2) / n, 
+                           (acc[x * 3 + 2] + n / 2) / n);
+    }
+    
+    memset(acc, 0, (size_t)dw * 3 * sizeof(uint32_t));
+    stream->acc_rows = 0;
+    stream->next_dst += stream->bottom_up ? -1 : 1;
+}
+
+/**
+ * 送入下一行源像素 (按存储顺序)
+ * row 为整行的BGR/BGRA数据；该行不会被用到时直接跳过，row 可以为NULL
+ */
+void fbtft_scale_stream_push_row(fbtft_scale_stream_t *stream, const uint8_t *row, int bytes_per_pixel) {
+    if (!stream || !stream->block || stream->next_row >= stream->src_height) return;
+    
+    int needed = fbtft_scale_stream_row_needed(stream);
+    int y = stream_row(stream);
+    stream->next_row++;
+    
+    if (!needed || !row || (bytes_per_pixel != 3 && bytes_per_pixel != 4)) return;
+    
+    const uint8_t *src = row + (size_t)stream->src_rect.x * bytes_per_pixel;
+    if (stream->filter == SCALE_BOX) {
+        stream_box_row(stream, src, bytes_per_pixel, y);
+    } else {
+        stream_bilinear_row(stream, src, bytes_per_pixel, y);
+    }
+}
+
+/**
+ * 释放流式缩小器
+ */
+void fbtft_scale_stream_destroy(fbtft_scale_stream_t *stream) {
+    if (!stream) return;
+    
+    fbtft_pool_free(stream->block);
+    memset(stream, 0, sizeof(*stream));
+}
@@ -0,0 +1,445 @@
+#include "fbtft_surface.h"
+#include "fbtft_blit.h"
+
+/**
+ * 简单的5x7点阵字体数据 (ASCII 32-126)
+ */
+static const unsigned char font_5x7[][7] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ' ' (space)
+    {0x04, 0x04, 0x04, 0x04, 0x00, 0x04, 0x00}, // '!'
+    {0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00}, // '"'
+    {0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x00, 0x00}, // '#'
+    {0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04}, // '$'
+    {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}, // '%'
+    {0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D}, // '&'
+    {0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00}, // '''
+    {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}, // '('
+    {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}, // ')'
+    {0x00, 0x0A, 0x04, 0x1F, 0x04, 0x0A, 0x00}, // '*'
+    {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}, // '+'
+    {0x00, 0x00, 0x00, 0x00, 0x04, 0x04, 0x08}, // ','
+    {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}, // '-'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00}, // '.'
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}, // '/'
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, // '0'
+    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, // '1'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, // '2'
+    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}, // '3'
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, // '4'
+    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, // '5'
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, // '6'
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, // '7'
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, // '8'
+    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, // '9'
+    {0x00, 0x04, 0x00, 0x00, 0x04, 0x00, 0x00}, // ':'
+    {0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x08}, // ';'
+    {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02}, // '<'
+    {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}, // '='
+    {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08}, // '>'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // '?'
+    {0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E}, // '@'
+    {0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11}, // 'A'
+    {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}, // 'B'
+    {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}, // 'C'
+    {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}, // 'D'
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}, // 'E'
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}, // 'F'
+    {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}, // 'G'
+    {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // 'H'
+    {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 'I'
+    {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}, // 'J'
+    {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}, // 'K'
+    {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}, // 'L'
+    {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}, // 'M'
+    {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}, // 'N'
+    {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'O'
+    {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}, // 'P'
+    {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}, // 'Q'
+    {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}, // 'R'
+    {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}, // 'S'
+    {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, // 'T'
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'U'
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}, // 'V'
+    {0x11, 0x11, 0x11, 0x15, 0x15, 0x1B, 0x11}, // 'W'
+    {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}, // 'X'
+    {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}, // 'Y'
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}, // 'Z'
+    {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // '['
+    {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00}, // '\'
+    {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E}, // ']'
+    {0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00}, // '^'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F}, // '_'
+    {0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00}, // '`'
+    {0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F}, // 'a'
+    {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E}, // 'b'
+    {0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E}, // 'c'
+    {0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F}, // 'd'
+    {0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E}, // 'e'
+    {0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08}, // 'f'
+    {0x00, 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01}, // 'g'
+    {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11}, // 'h'
+    {0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E}, // 'i'
+    {0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C}, // 'j'
+    {0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12}, // 'k'
+    {0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 'l'
+    {0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11}, // 'm'
+    {0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11}, // 'n'
+    {0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E}, // 'o'
+    {0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10}, // 'p'
+    {0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01}, // 'q'
+    {0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10}, // 'r'
+    {0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E}, // 's'
+    {0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06}, // 't'
+    {0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D}, // 'u'
+    {0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04}, // 'v'
+    {0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A}, // 'w'
+    {0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11}, // 'x'
+    {0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E}, // 'y'
+    {0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F}, // 'z'
+};
+
+/**
+ * 求矩形与裁剪矩形的交集，交集为空返回0
+ */
+static int clip_to_surface(const fbtft_surface_t *surface, fbtft_rect_t *r) {
+    int x1 = r->x > surface->clip.x ? r->x : surface->clip.x;
+    int y1 = r->y > surface->clip.y ? r->y : surface->clip.y;
+    int x2 = r->x + r->w;
+    int y2 = r->y + r->h;
+    int cx2 = surface->clip.x + surface->clip.w;
+    int cy2 = surface->clip.y + surface->clip.h;
+    
+    if (x2 > cx2) x2 = cx2;
+    if (y2 > cy2) y2 = cy2;
+    
+    r->x = x1;
+    r->y = y1;
+    r->w = x2 - x1;
+    r->h = y2 - y1;
+    return (r->w > 0 && r->h > 0);
+}
+
+/**
+ * 判断像素是否在裁剪矩形内
+ */
+static inline int in_clip(const fbtft_surface_t *surface, int x, int y) {
+    return x >= surface->clip.x && x < surface->clip.x + surface->clip.w &&
+           y >= surface->clip.y && y < surface->clip.y + surface->clip.h;
+}
+
+/**
+ * 取得表面第y行的起始地址
+ */
+static inline uint16_t *surface_row(const fbtft_surface_t *surface, int y) {
+    return surface->pixels + (size_t)y * surface->stride;
+}
+
+/**
+ * 创建一个由表面自己分配内存的表面
+ */
+int fbtft_surface_create(fbtft_surface_t *surface, int width, int height) {
+    if (!surface || width <= 0 || height <= 0) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    uint16_t *pixels = (uint16_t *)malloc((size_t)width * height * sizeof(uint16_t));
+    if (!pixels) {
+        fprintf(stderr, "Error: Cannot allocate surface memory\n");
+        return -1;
+    }
+    
+    fbtft_surface_wrap(surface, pixels, width, height, width);
+    surface->owns_pixels = 1;
+    return 0;
+}
+
+/**
+ * 包装调用者提供的像素缓冲区
+ * @param stride 每行像素数，传0表示等于width
+ */
+int fbtft_surface_wrap(fbtft_surface_t *surface, uint16_t *pixels, int width, int height, int stride) {
+    if (!surface || !pixels || width <= 0 || height <= 0) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    if (stride == 0) {
+        stride = width;
+    }
+    if (stride < width) {
+        fprintf(stderr, "Error: Surface stride %d smaller than width %d\n", stride, width);
+        return -1;
+    }
+    
+    surface->pixels = pixels;
+    surface->width = width;
+    surface->height = height;
+    surface->stride = stride;
+    surface->owns_pixels = 0;
+    fbtft_surface_reset_clip(surface);
+    return 0;
+}
+
+/**
+ * 包装LCD当前的后台缓冲区 (单缓冲模式下就是显示页)
+ */
+int fbtft_surface_wrap_lcd(fbtft_surface_t *surface, fbtft_lcd_t *lcd) {
+    uint16_t *pixels = fbtft_lcd_get_back_buffer(lcd);
+    if (!pixels) {
+        fprintf(stderr, "Error: LCD not initialized\n");
+        return -1;
+    }
+    
+    return fbtft_surface_wrap(surface, pixels, lcd->width, lcd->height, fbtft_lcd_get_stride(lcd));
+}
+
+/**
+ * 创建父表面中一个子矩形的视图，与父表面共享像素内存
+ * 子矩形会被裁剪到父表面范围内，视图继承父表面的裁剪矩形
+ */
+int fbtft_surface_sub(fbtft_surface_t *view, const fbtft_surface_t *parent, int x, int y, int w, int h) {
+    if (!view || !parent || !parent->pixels) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    fbtft_rect_t r = { x, y, w, h };
+    fbtft_rect_t bounds = { 0, 0, parent->width, parent->height };
+    fbtft_surface_t full = *parent;
+    full.clip = bounds;
+    if (!clip_to_surface(&full, &r)) {
+        return -1;
+    }
+    
+    fbtft_rect_t clip = parent->clip;
+    
+    view->pixels = surface_row(parent, r.y) + r.x;
+    view->width = r.w;
+    view->height = r.h;
+    view->stride = parent->stride;
+    view->owns_pixels = 0;
+    
+    // 把父表面的裁剪矩形换算到视图坐标
+    fbtft_surface_reset_clip(view);
+    fbtft_surface_set_clip(view, clip.x - r.x, clip.y - r.y, clip.w, clip.h);
+    return 0;
+}
+
+/**
+ * 释放表面 (只释放表面自己分配的内存)
+ */
+void fbtft_surface_destroy(fbtft_surface_t *surface) {
+    if (!surface) return;
+    
+    if (surface->owns_pixels && surface->pixels) {
+        free(surface->pixels);
+    }
+    memset(surface, 0, sizeof(*surface));
+}
+
+/**
+ * 设置裁剪矩形，自动限制在表面范围内
+ */
+void fbtft_surface_set_clip(fbtft_surface_t *surface, int x, int y, int w, int h) {
+    if (!surface) return;
+    
+    fbtft_rect_t r = { x, y, w, h };
+    fbtft_surface_reset_clip(surface);
+    if (!clip_to_surface(surface, &r)) {
+        r.w = 0;
+        r.h = 0;
+    }
+    surface->clip = r;
+}
+
+/**
+ * 把裁剪矩形恢复为整个表面
+ */
+void fbtft_surface_reset_clip(fbtft_surface_t *surface) {
+    if (!surface) return;
+    
+    surface->clip.x = 0;
+    surface->clip.y = 0;
+    surface->clip.w = surface->width;
+    surface->clip.h = surface->height;
+}
+
+/**
+ * 用指定颜色填充整个裁剪矩形
+ */
+void fbtft_surface_clear(fbtft_surface_t *surface, uint16_t color) {
+    if (!surface) return;
+    fbtft_surface_fill_rect(surface, surface->clip.x, surface->clip.y, 
+                            surface->clip.w, surface->clip.h, color);
+}
+
+/**
+ * 设置单个像素 (裁剪矩形以外的像素被忽略)
+ */
+void fbtft_surface_set_pixel(fbtft_surface_t *surface, int x, int y, uint16_t color) {
+    if (!surface || !in_clip(surface, x, y)) return;
+    surface_row(surface, y)[x] = color;
+}
+
+/**
+ * 获取单个像素 (超出表面范围返回0)
+ */
+uint16_t fbtft_surface_get_pixel(const fbtft_surface_t *surface, int x, int y) {
+    if (!surface || x < 0 || y < 0 || x >= surface->width || y >= surface->height) {
+        return 0;
+    }
+    return surface_row(surface, y)[x];
+}
+
+/**
+ * 填充矩形 (x, y, w, h)，只裁剪一次
+ */
+void fbtft_surface_fill_rect(fbtft_surface_t *surface, int x, int y, int w, int h, uint16_t color) {
+    if (!surface || !surface->pixels) return;
+    
+    fbtft_rect_t r = { x, y, w, h };
+    if (!clip_to_surface(surface, &r)) return;
+    
+    fbtft_blit_fill(surface_row(surface, r.y) + r.x, (size_t)surface->stride * sizeof(uint16_t), 
+                    r.w, r.h, color);
+}
+
+/**
+ * 绘制矩形边框 (x, y, w, h)
+ */
+void fbtft_surface_draw_rect(fbtft_surface_t *surface, int x, int y, int w, int h, uint16_t color) {
+    if (w <= 0 || h <= 0) return;
+    
+    fbtft_surface_fill_rect(surface, x, y, w, 1, color);
+    if (h > 1) {
+        fbtft_surface_fill_rect(surface, x, y + h - 1, w, 1, color);
+    }
+    fbtft_surface_fill_rect(surface, x, y, 1, h, color);
+    if (w > 1) {
+        fbtft_surface_fill_rect(surface, x + w - 1, y, 1, h, color);
+    }
+}
+
+/**
+ * 把源表面的一个矩形复制到目标表面
+ * 源矩形按源表面范围裁剪，目标按目标裁剪矩形裁剪
+ */
+void fbtft_surface_blit(fbtft_surface_t *dst, int dst_x, int dst_y, 
+                        const fbtft_surface_t *src, int src_x, int src_y, int w, int h) {
+    if (!dst || !src || !dst->pixels || !src->pixels) return;
+    
+    // 按源表面范围裁剪
+    if (src_x < 0) { dst_x -= src_x; w += src_x; src_x = 0; }
+    if (src_y < 0) { dst_y -= src_y; h += src_y; src_y = 0; }
+    if (src_x + w > src->width) w = src->width - src_x;
+    if (src_y + h > src->height) h = src->height - src_y;
+    
+    // 按目标裁剪矩形裁剪，同步移动源坐标
+    fbtft_rect_t r = { dst_x, dst_y, w, h };
+    if (!clip_to_surface(dst, &r)) return;
+    src_x += r.x - dst_x;
+    src_y += r.y - dst_y;
+    
+    fbtft_blit_copy(surface_row(dst, r.y) + r.x, (size_t)dst->stride * sizeof(uint16_t), 
+                    surface_row(src, src_y) + src_x, (size_t)src->stride * sizeof(uint16_t), 
+                    r.w, r.h);
+}
+
+/**
+ * 取得字符的点阵数据，不支持的字符返回NULL
+ */
+static const unsigned char *font_glyph(char c) {
+    int font_index = c - 32;
+    
+    // 支持 ASCII 32-122 (空格到小写z)
+    if (font_index < 0 || font_index >= (int)(sizeof(font_5x7) / sizeof(font_5x7[0]))) {
+        return NULL;
+    }
+    return font_5x7[font_index];
+}
+
+/**
+ * 判断字符点阵中 (row, col) 是否需要绘制
+ * 不支持的字符绘制为一个方框
+ */
+static inline int glyph_bit(const unsigned char *glyph, int row, int col) {
+    if (!glyph) {
+        return row == 0 || row == FBTFT_FONT_HEIGHT - 1 || col == 0 || col == 4;
+    }
+    return (glyph[row] >> (4 - col)) & 1;
+}
+
+/**
+ * 水平绘制文本，背景色填充整个文本框
+ */
+void fbtft_surface_draw_text(fbtft_surface_t *surface, int x, int y, const char *text, 
+                             uint16_t color, uint16_t bg_color) {
+    if (!surface || !text) return;
+    
+    int len = strlen(text);
+    
+    // 绘制背景矩形
+    fbtft_surface_fill_rect(surface, x, y, len * FBTFT_FONT_WIDTH, FBTFT_FONT_HEIGHT, bg_color);
+    
+    // 绘制每个字符
+    for (int i = 0; i < len; i++) {
+        const unsigned char *glyph = font_glyph(text[i]);
+        int char_x = x + i * FBTFT_FONT_WIDTH;
+        
+        for (int row = 0; row < FBTFT_FONT_HEIGHT; row++) {
+            for (int col = 0; col < 5; col++) {
+                if (glyph_bit(glyph, row, col)) {
+                    fbtft_surface_set_pixel(surface, char_x + col, y + row, color);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * 竖直绘制文本 (字符逆时针旋转90度，用于横屏显示)，背景色填充整个文本框
+ */
+void fbtft_surface_draw_text_vertical(fbtft_surface_t *surface, int x, int y, const char *text, 
+                                      uint16_t color, uint16_t bg_color) {
+    if (!surface || !text) return;
+    
+    int len = strlen(text);
+    
+    // 绘制背景矩形 (旋转后宽为字符高度，高为文本长度)
+    fbtft_surface_fill_rect(surface, x, y, FBTFT_FONT_HEIGHT, len * FBTFT_FONT_WIDTH, bg_color);
+    
+    // 绘制每个字符，字符的行变成列，列逆序变成行
+    for (int i = 0; i < len; i++) {
+        const unsigned char *glyph = font_glyph(text[i]);
+        int char_y = y + i * FBTFT_FONT_WIDTH;
+        
+        for (int row = 0; row < FBTFT_FONT_HEIGHT; row++) {
+            for (int col = 0; col < 5; col++) {
+                if (glyph_bit(glyph, row, col)) {
+                    fbtft_surface_set_pixel(surface, x + row, char_y + (4 - col), color);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * 把表面显示到LCD
+ * @param damage 脏区域列表，为NULL时显示整帧
+ * @return 成功返回0，失败返回-1
+ */
+int fbtft_surface_present(const fbtft_surface_t *surface, fbtft_lcd_t *lcd, const fbtft_damage_t *damage) {
+    if (!surface || !lcd || !surface->pixels) {
+        fprintf(stderr, "Error: Invalid parameters\n");
+        return -1;
+    }
+    
+    if (surface->width != lcd->width || surface->height != lcd->height) {
+        fprintf(stderr, "Error: Surface size %dx%d does not match LCD %dx%d\n", 
+                surface->width, surface->height, lcd->width, lcd->height);
+        return -1;
+    }
+    
+    return fbtft_lcd_display_strided(lcd, surface->pixels, surface->stride, damage);
+}
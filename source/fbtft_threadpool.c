@@ -0,0 +1,219 @@
+#include "fbtft_threadpool.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+// 一次并行任务
+typedef struct {
+    fbtft_band_fn_t fn;                 // 条带处理函数
+    void *ctx;                          // 处理函数的参数
+    int rows;                           // 总行数
+    int band_rows;                      // 每个条带的行数
+    int bands;                          // 条带数量
+    int next_band;                      // 下一个待领取的条带 (原子操作)
+    int pending;                        // 尚未完成的工作线程数 (受lock保护)
+} band_job_t;
+
+// 线程池状态
+static struct {
+    pthread_mutex_t lock;               // 保护任务发布和完成计数
+    pthread_cond_t work_cond;           // 有新任务
+    pthread_cond_t done_cond;           // 工作线程完成了当前任务
+    pthread_mutex_t submit_lock;        // 同一时间只执行一个并行任务
+    pthread_t threads[FBTFT_THREADPOOL_MAX_THREADS];
+    int num_workers;                    // 工作线程数 (不含调用线程)
+    unsigned long generation;           // 任务序号，工作线程据此判断是否有新任务
+    int shutdown;                       // 通知工作线程退出
+    band_job_t *job;                    // 当前任务
+} pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work_cond = PTHREAD_COND_INITIALIZER,
+    .done_cond = PTHREAD_COND_INITIALIZER,
+    .submit_lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+// 当前线程是否为线程池的工作线程 (工作线程中的嵌套调用直接串行执行)
+static __thread int in_worker;
+
+/**
+ * 领取并处理条带，直到所有条带都被领取
+ */
+static void run_bands(band_job_t *job) {
+    for (;;) {
+        int band = __atomic_fetch_add(&job->next_band, 1, __ATOMIC_RELAXED);
+        if (band >= job->bands) break;
+
+        int begin = band * job->band_rows;
+        int end = begin + job->band_rows < job->rows ? begin + job->band_rows : job->rows;
+        job->fn(job->ctx, begin, end);
+    }
+}
+
+/**
+ * 工作线程主循环
+ */
+static void *worker_main(void *arg) {
+    // 创建时的任务序号，之后发布的任务都要参与
+    unsigned long seen = (unsigned long)(uintptr_t)arg;
+
+    in_worker = 1;
+
+    pthread_mutex_lock(&pool.lock);
+    for (;;) {
+        while (!pool.shutdown && pool.generation == seen) {
+            pthread_cond_wait(&pool.work_cond, &pool.lock);
+        }
+        if (pool.shutdown) break;
+
+        seen = pool.generation;
+        band_job_t *job = pool.job;
+        pthread_mutex_unlock(&pool.lock);
+
+        run_bands(job);
+
+        pthread_mutex_lock(&pool.lock);
+        if (--job->pending == 0) {
+            pthread_cond_signal(&pool.done_cond);
+        }
+    }
+    pthread_mutex_unlock(&pool.lock);
+
+    return NULL;
+}
+
+/**
+ * 停止并回收所有工作线程 (调用者持有submit_lock)
+ */
+static void stop_workers(void) {
+    if (pool.num_workers == 0) return;
+
+    pthread_mutex_lock(&pool.lock);
+    pool.shutdown = 1;
+    pthread_cond_broadcast(&pool.work_cond);
+    pthread_mutex_unlock(&pool.lock);
+
+    for (int i = 0; i < pool.num_workers; i++) {
+        pthread_join(pool.threads[i], NULL);
+    }
+
+    pool.shutdown = 0;
+    __atomic_store_n(&pool.num_workers, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * 设置线程数 (含调用线程)
+ * @param num_threads 0表示按在线CPU核数自动选择，1表示单线程
+ * @return 实际使用的线程数，失败返回-1
+ */
+int fbtft_threadpool_set_threads(int num_threads) {
+    if (num_threads < 0) {
+        fprintf(stderr, "Error: Invalid thread count %d\n", num_threads);
+        return -1;
+    }
+
+    if (num_threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (num_threads > FBTFT_THREADPOOL_MAX_THREADS) {
+        num_threads = FBTFT_THREADPOOL_MAX_THREADS;
+    }
+
+    // 等待正在执行的并行任务结束
+    pthread_mutex_lock(&pool.submit_lock);
+
+    if (pool.num_workers == num_threads - 1) {
+        pthread_mutex_unlock(&pool.submit_lock);
+        return num_threads;
+    }
+
+    stop_workers();
+
+    int created = 0;
+    for (int i = 0; i < num_threads - 1; i++) {
+        if (pthread_create(&pool.threads[i], NULL, worker_main,
+                           (void *)(uintptr_t)pool.generation) != 0) {
+            perror("Error: Failed to create worker thread");
+            break;
+        }
+        created++;
+    }
+    __atomic_store_n(&pool.num_workers, created, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&pool.submit_lock);
+
+    return created + 1;
+}
+
+/**
+ * 获取当前线程数 (含调用线程)
+ */
+int fbtft_threadpool_get_threads(void) {
+    return __atomic_load_n(&pool.num_workers, __ATOMIC_ACQUIRE) + 1;
+}
+
+/**
+ * 回收所有工作线程，恢复单线程
+ */
+void fbtft_threadpool_shutdown(void) {
+    pthread_mutex_lock(&pool.submit_lock);
+    stop_workers();
+    pthread_mutex_unlock(&pool.submit_lock);
+}
+
+/**
+ * 按条带并行处理 rows 行
+ * 单线程、数据量很小、在工作线程中嵌套调用或线程池正被其他线程占用时，
+ * 直接在调用线程中一次处理全部行，不加锁也不做任何同步
+ */
+void fbtft_parallel_rows(int rows, size_t row_bytes, fbtft_band_fn_t fn, void *ctx) {
+    if (rows <= 0 || !fn) return;
+
+    int workers = __atomic_load_n(&pool.num_workers, __ATOMIC_ACQUIRE);
+    if (workers == 0 || in_worker || rows < 2 ||
+        (size_t)rows * row_bytes < FBTFT_PARALLEL_MIN_BYTES ||
+        pthread_mutex_trylock(&pool.submit_lock) != 0) {
+        fn(ctx, 0, rows);
+        return;
+    }
+
+    // 持有submit_lock期间线程数不会变化，重新读取一次
+    workers = pool.num_workers;
+    if (workers == 0) {
+        pthread_mutex_unlock(&pool.submit_lock);
+        fn(ctx, 0, rows);
+        return;
+    }
+
+    band_job_t job;
+    memset(&job, 0, sizeof(job));
+    job.fn = fn;
+    job.ctx = ctx;
+    job.rows = rows;
+    job.band_rows = row_bytes ? (int)(FBTFT_PARALLEL_BAND_BYTES / row_bytes) : rows;
+    if (job.band_rows < 1) job.band_rows = 1;
+    job.bands = (rows + job.band_rows - 1) / job.band_rows;
+    job.pending = workers;
+
+    // 发布任务并唤醒工作线程
+    pthread_mutex_lock(&pool.lock);
+    pool.job = &job;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.work_cond);
+    pthread_mutex_unlock(&pool.lock);
+
+    // 调用线程也参与处理
+    run_bands(&job);
+
+    // 等待所有工作线程离开当前任务 (job位于本函数的栈上)
+    pthread_mutex_lock(&pool.lock);
+    while (job.pending > 0) {
+        pthread_cond_wait(&pool.done_cond, &pool.lock);
+    }
+    pool.job = NULL;
+    pthread_mutex_unlock(&pool.lock);
+
+    pthread_mutex_unlock(&pool.submit_lock);
+}
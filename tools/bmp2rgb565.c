@@ -0,0 +1,94 @@
+#include "fbtft_asset.h"
+#include <getopt.h>
+
+/**
+ * 打印用法
+ */
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [options] input.bmp output.f565\n", prog);
+    fprintf(stderr, "Convert a BMP image into a pre-fitted RGB565 asset for a fixed panel\n\n");
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  -s WxH        Panel size in framebuffer orientation (default 240x320)\n");
+    fprintf(stderr, "  -f MODE       Fit mode: scale, stretch, auto (default scale)\n");
+    fprintf(stderr, "  -r DEGREES    Rotation: 0, 90, 180, 270 (default 0)\n");
+    fprintf(stderr, "  -m MODE       Mirror: none, horizontal, vertical, both (default none)\n");
+    fprintf(stderr, "  -h            Show this help\n");
+}
+
+int main(int argc, char *argv[]) {
+    int panel_width = 240;
+    int panel_height = 320;
+    fit_mode_t fit = FIT_SCALE;
+    rotation_t rotation = ROTATE_0;
+    mirror_t mirror = MIRROR_NONE;
+    int opt;
+    
+    while ((opt = getopt(argc, argv, "s:f:r:m:h")) != -1) {
+        switch (opt) {
+            case 's':
+                if (sscanf(optarg, "%dx%d", &panel_width, &panel_height) != 2 || 
+                    panel_width <= 0 || panel_height <= 0) {
+                    fprintf(stderr, "Error: Invalid panel size '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'f':
+                if (strcmp(optarg, "scale") == 0) {
+                    fit = FIT_SCALE;
+                } else if (strcmp(optarg, "stretch") == 0) {
+                    fit = FIT_STRETCH;
+                } else if (strcmp(optarg, "auto") == 0) {
+                    fit = FIT_AUTO;
+                } else {
+                    fprintf(stderr, "Error: Invalid fit mode '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'r': {
+                int degrees = atoi(optarg);
+                if (degrees != 0 && degrees != 90 && degrees != 180 && degrees != 270) {
+                    fprintf(stderr, "Error: Invalid rotation '%s'\n", optarg);
+                    return 1;
+                }
+                rotation = (rotation_t)degrees;
+                break;
+            }
+            case 'm':
+                if (strcmp(optarg, "none") == 0) {
+                    mirror = MIRROR_NONE;
+                } else if (strcmp(optarg, "horizontal") == 0) {
+                    mirror = MIRROR_HORIZONTAL;
+                } else if (strcmp(optarg, "vertical") == 0) {
+                    mirror = MIRROR_VERTICAL;
+                } else if (strcmp(optarg, "both") == 0) {
+                    mirror = MIRROR_BOTH;
+                } else {
+                    fprintf(stderr, "Error: Invalid mirror mode '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    
+    if (argc - optind != 2) {
+        usage(argv[0]);
+        return 1;
+    }
+    
+    const char *input = argv[optind];
+    const char *output = argv[optind + 1];
+    
+    if (fbtft_asset_convert_bmp(input, output, panel_width, panel_height, fit, rotation, mirror, NULL) != 0) {
+        fprintf(stderr, "Error: Failed to convert %s\n", input);
+        return 1;
+    }
+    
+    printf("Asset written: %s (%dx%d, rotation %d)\n", output, panel_width, panel_height, rotation);
+    return 0;
+}